@@ -0,0 +1,78 @@
+/// @file       arena.h
+/// @brief      Файл с объявлениями модуля выделения памяти из арены
+/// @details    Арена выделяет память блоками и освобождает ее целиком за один вызов.
+///                 Адреса выделенной памяти остаются неизменными до очистки арены,
+///                 что позволяет хранить на них указатели. <br>
+///                 Порядок работы с модулем: <br>
+///                 1) arenaAlloc() или arenaStringCopy() для выделения памяти из арены <br>
+///                 2) arenaClear() для освобождения всей памяти арены
+/// @author     Тузиков Г.А. janisrus35@gmail.com
+
+#ifndef _ARENA_H_
+#define _ARENA_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+
+/*
+    Макроподстановки
+*/
+
+/// @brief      Минимальный размер блока арены
+#define ARENA_BLOCK_SIZE_MIN (64 * 1024)
+
+/// @brief      Выравнивание памяти, выделяемой из арены
+#define ARENA_ALIGNMENT (sizeof(void *))
+
+/*
+    Структуры
+*/
+
+/// @brief      Структура блока арены
+typedef struct arenaBlockStruct
+{
+    struct arenaBlockStruct *nextPtr; ///< Указатель на предыдущий заполненный блок
+    size_t                   size;    ///< Размер данных блока
+    size_t                   used;    ///< Количество занятых байт блока
+    char                     data[];  ///< Данные блока
+}arenaBlockStruct;
+
+/// @brief      Структура арены
+/// @note       Обнуленная структура является пустой ареной
+typedef struct arenaStruct
+{
+    arenaBlockStruct *blockPtr; ///< Указатель на текущий блок
+}arenaStruct;
+
+/*
+    Прототипы функций
+*/
+
+/// @brief      Функция выделения памяти из арены
+/// @details    Данная функция выполняет выделение size байт из текущего блока арены.
+///                 Если места в текущем блоке недостаточно, выделяется новый блок
+/// @param[in]  arenaPtr Указатель на арену
+/// @param[in]  size     Количество байт
+/// @param[out] isOkPtr  Указатель на флаг успешного выполнения операции. Может быть равен 0
+/// @return     Возвращает указатель на выделенную память, выровненную по ARENA_ALIGNMENT.
+///                 В случае ошибки возвращает 0
+void *arenaAlloc(arenaStruct *arenaPtr, size_t size, bool *isOkPtr);
+
+/// @brief      Функция копирования строки в арену
+/// @details    Данная функция выполняет выделение stringLength + 1 байт из арены
+///                 и копирование в них stringPtr с \0
+/// @param[in]  arenaPtr     Указатель на арену
+/// @param[in]  stringPtr    Указатель на строку
+/// @param[in]  stringLength Длина stringPtr без \0
+/// @param[out] isOkPtr      Указатель на флаг успешного выполнения операции. Может быть равен 0
+/// @return     Возвращает указатель на копию строки.
+///                 В случае ошибки возвращает 0
+char *arenaStringCopy(arenaStruct *arenaPtr, const char *stringPtr, size_t stringLength, bool *isOkPtr);
+
+/// @brief      Функция очистки арены
+/// @details    Данная функция выполняет освобождение всех блоков арены
+/// @param[in]  arenaPtr Указатель на арену. Может быть равен 0
+void arenaClear(arenaStruct *arenaPtr);
+
+// _ARENA_H_
+#endif
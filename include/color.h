@@ -1,7 +1,10 @@
 /// @file       color.h
 /// @brief      Файл с объявлениями модуля работы с цветами
-/// @details    Порядок работы с модулем: <br>
-///                 1) colorUpdateColorsList() для обновления списка цветов в соответствии с LS_COLORS <br>
+/// @details    LS_COLORS разбирается один раз в таблицу готовых escape-последовательностей:
+///                 цвета типов файлов хранятся в массиве с индексом colorKeysEnum,
+///                 цвета расширений - в отдельном списке. <br>
+///                 Порядок работы с модулем: <br>
+///                 1) colorUpdateColorsList() для построения таблицы цветов в соответствии с LS_COLORS <br>
 ///                 2) colorGetReset() для получения escape-последовательности сброса цвета <br>
 ///                 3) colorFileToESC() для получения escape-последовательности с цветом, соответствующим файлу <br>
 /// @author     Тузиков Г.А. janisrus35@gmail.com
@@ -14,56 +17,73 @@
 #include "fileInfo.h"
 
 /*
-    Макроподстановки
+    Перечисления
 */
 
-/// @brief      Максимальное количество ключей, берущихся из LS_COLORS
-#define COLOR_KEY_MAX_COUNT 256
-
-/// @brief      Максимальная длина ключа, берущегося из LS_COLORS
-#define COLOR_KEY_MAX_LENGTH 10
-
-/// @brief      Максимальное количество ANSI команд, берущихся из LS_COLORS
-#define COLOR_ANSI_MAX_COUNT 5
-
-/// @brief      Максимальная длина ANSI команд в строковом виде
-/// @note       Один SGR код занимает 2 символа + разделитель ;
-#define COLOR_ANSI_MAX_LENGTH (COLOR_ANSI_MAX_COUNT * 3)
-
-/// @brief      Максимальная escape-последовательности
-/// @note       Длина \033[m = 6
-#define COLOR_ESC_MAX_LENGTH (COLOR_ANSI_MAX_LENGTH + 6)
+/// @brief      Перечисление ключей LS_COLORS, обозначающих типы файлов
+/// @note       Порядок совпадает с порядком списка цветов по умолчанию
+typedef enum colorKeysEnum
+{
+    colorKeyFile = 0,            ///< fi. Обычный файл
+    colorKeyNormal,              ///< no. Обычный файл
+    colorKeyReset,               ///< rs. Сброс цвета
+    colorKeyDirectory,           ///< di. Директория
+    colorKeyLink,                ///< ln. Симлинк
+    colorKeyMultiHardLink,       ///< mh. Файл с несколькими жесткими ссылками
+    colorKeyFIFO,                ///< pi. FIFO
+    colorKeySock,                ///< so. Сокет
+    colorKeyDoor,                ///< do. Особый IPC файл
+    colorKeyBlock,               ///< bd. Блочное устройство
+    colorKeyChar,                ///< cd. Символьное устройство
+    colorKeyOrphan,              ///< or. Цель ссылки отсутствует
+    colorKeyMissing,             ///< mi. Файл не обнаружен
+    colorKeySetUid,              ///< su. Файл с правами владельца s/S
+    colorKeySetGid,              ///< sg. Файл с правами группы s/S
+    colorKeyCapability,          ///< ca. Файл совместимости
+    colorKeyStickyOtherWritable, ///< tw. Директория с правами прочих t/T и w
+    colorKeyOtherWritable,       ///< ow. Директория с правами прочих w
+    colorKeySticky,              ///< st. Директория с правами прочих t/T
+    colorKeyExecutable,          ///< ex. Исполняемый файл
+    colorKeyCount                ///< Количество ключей
+}colorKeysEnum;
 
 /*
     Структуры
 */
 
-#pragma pack (push, 1)
+/// @brief      Структура escape-последовательности
+typedef struct colorESCStruct
+{
+    const char *stringPtr; ///< Escape-последовательность с \0
+    size_t      length;    ///< Длина stringPtr без \0
+    bool        isReset;   ///< Флаг совпадения с escape-последовательностью сброса цвета
+}colorESCStruct;
 
 /// @brief      Структура цветов файла и цели символической ссылки
+/// @details    Указатели ссылаются в таблицу цветов и действительны до следующего вызова colorUpdateColorsList()
 typedef struct colorFileTargetStruct
 {
-    char file  [COLOR_ESC_MAX_LENGTH]; ///< Escape-последовательность с цветом файла
-    char target[COLOR_ESC_MAX_LENGTH]; ///< Escape-последовательность с цветом цели символической ссылки
+    const colorESCStruct *filePtr;   ///< Escape-последовательность с цветом файла
+    const colorESCStruct *targetPtr; ///< Escape-последовательность с цветом цели символической ссылки
 }colorFileTargetStruct;
 
-#pragma pack (pop)
-
 /*
     Прототипы функций
 */
 
-/// @brief      Функция обновления списка цветов
-/// @details    Данная функция выполняет обновление colorList,
-///                 используя информацию из переменной окружения LS_COLORS
-/// @note       Отсутствующие Ansi коды берутся из colorListDefault
-/// @return     Возвращает true в случае успешного обновления colorList.
-///                 В противном случае, возвращает false
+/// @brief      Функция построения таблицы цветов
+/// @details    Данная функция выполняет разбор переменной окружения LS_COLORS
+///                 в таблицу готовых escape-последовательностей. Сама переменная не изменяется
+/// @note       Отсутствующие Ansi коды берутся из colorListDefault.
+///                 Если ключ встречается несколько раз, используется первое вхождение
+/// @return     Возвращает true в случае успешного построения таблицы по LS_COLORS.
+///                 Если LS_COLORS не задана или не хватило памяти, таблица строится по цветам по умолчанию
+///                 и возвращается false
 bool colorUpdateColorsList(void);
 
 /// @brief      Функция получения escape-последовательности, сбрасывающей цвета
-/// @return     Возвращает escape-последовательность, сбрасывающую цвета
-const char *colorGetReset(void);
+/// @return     Возвращает указатель на escape-последовательность сброса цвета
+const colorESCStruct *colorGetReset(void);
 
 /// @brief      Функция получения цветов файла и цели символической ссылки
 /// @details    Данная функция выполняет определение цветов, которыми необходимо раскрасить 
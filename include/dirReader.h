@@ -0,0 +1,85 @@
+/// @file       dirReader.h
+/// @brief      Файл с объявлениями модуля чтения содержимого директории
+/// @details    Модуль выполняет чтение записей директории системным вызовом getdents64
+///                 в буфер большого размера, что сокращает количество системных вызовов
+///                 по сравнению с readdir(). <br>
+///                 Порядок работы с модулем: <br>
+///                 1) dirReaderOpen() для открытия директории <br>
+///                 2) dirReaderNext() для получения очередной записи директории <br>
+///                 3) dirReaderClose() для закрытия директории и очистки занятых ресурсов
+/// @author     Тузиков Г.А. janisrus35@gmail.com
+
+#ifndef _DIR_READER_H_
+#define _DIR_READER_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/*
+    Макроподстановки
+*/
+
+/// @brief      Размер буфера для записей директории по умолчанию
+#define DIR_READER_BUFFER_SIZE_DEFAULT (256 * 1024)
+
+/// @brief      Минимальный размер буфера для записей директории
+/// @note       Буфер должен вмещать хотя бы одну запись с именем максимальной длины
+#define DIR_READER_BUFFER_SIZE_MIN (4 * 1024)
+
+/*
+    Структуры
+*/
+
+/// @brief      Структура записи директории
+/// @warning    namePtr указывает в буфер dirReaderStruct и действителен до следующего вызова dirReaderNext()
+typedef struct dirReaderEntryStruct
+{
+    uint64_t    inode;      ///< Номер inode
+    uint8_t     type;       ///< Тип файла (DT_*)
+    const char *namePtr;    ///< Указатель на имя файла
+    size_t      nameLength; ///< Длина имени файла без \0
+}dirReaderEntryStruct;
+
+/// @brief      Структура чтения директории
+typedef struct dirReaderStruct
+{
+    int    fd;           ///< Дескриптор директории
+    char  *bufferPtr;    ///< Буфер для записей директории
+    size_t bufferSize;   ///< Размер bufferPtr
+    size_t bufferLength; ///< Количество данных в bufferPtr
+    size_t position;     ///< Позиция следующей записи в bufferPtr
+}dirReaderStruct;
+
+/*
+    Прототипы функций
+*/
+
+/// @brief      Функция открытия директории
+/// @details    Данная функция выполняет открытие директории dirPtr и выделение буфера размером bufferSize
+/// @warning    Данная функция использует malloc!
+///                 Не забудьте очистить память, вызвав dirReaderClose()!
+/// @param[out] readerPtr  Указатель на структуру чтения директории
+/// @param[in]  dirPtr     Указатель на путь к директории
+/// @param[in]  bufferSize Размер буфера. Если равен 0, используется DIR_READER_BUFFER_SIZE_DEFAULT
+/// @param[out] isOkPtr    Указатель на флаг успешного выполнения операции. Может быть равен 0
+void dirReaderOpen(dirReaderStruct *readerPtr, const char *dirPtr, size_t bufferSize, bool *isOkPtr);
+
+/// @brief      Функция получения очередной записи директории
+/// @details    Данная функция выполняет разбор очередной записи из буфера.
+///                 Если буфер исчерпан, он заполняется новым вызовом getdents64
+/// @param[in]  readerPtr Указатель на структуру чтения директории
+/// @param[out] entryPtr  Указатель на запись директории
+/// @param[out] isOkPtr   Указатель на флаг успешного выполнения операции. Может быть равен 0
+/// @return     Возвращает true, если запись получена.
+///                 Если записи закончились или произошла ошибка, возвращает false
+bool dirReaderNext(dirReaderStruct *readerPtr, dirReaderEntryStruct *entryPtr, bool *isOkPtr);
+
+/// @brief      Функция закрытия директории
+/// @details    Данная функция выполняет закрытие дескриптора директории и очистку буфера
+/// @param[in]  readerPtr Указатель на структуру чтения директории. Может быть равен 0
+/// @note       Допускается вызов для обнуленной или не открытой структуры
+void dirReaderClose(dirReaderStruct *readerPtr);
+
+// _DIR_READER_H_
+#endif
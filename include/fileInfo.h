@@ -2,11 +2,12 @@
 /// @brief      Файл с объявлениями модуля получения данных о файле
 /// @details    Порядок работы с модулем: <br>
 ///                 1) fileInfoIsExists() для проверки существования файла <br>
-///                 2) fileInfoGet() для получения всей информации о файле <br>
-///                 3) fileInfoSetActiveFile() для установки активного файла <br>
-///                 4) fileInfoClearActiveFile() для сброса активного файла <br>
-///                 5) Функции с префиксом fileInfoGet для получения информации об активном файле <br>
-///                 6) fileInfoToString() для получения строкового представления всей информации о файле <br>
+///                 2) fileInfoGet() или fileInfoGetBatchAt() для получения всей информации о файле
+///                     или группе файлов и fileInfoClear() для ее очистки <br>
+///                 3) fileInfoContextSetFile() для установки текущего файла контекста <br>
+///                 4) fileInfoContextClear() для очистки контекста <br>
+///                 5) Функции с префиксом fileInfoGet для получения информации о текущем файле контекста <br>
+///                 6) fileInfoToColumns() для получения строкового представления всей информации о файле <br>
 ///                 7) Функции с префиксом fileInfoToString для получения строкового представления информации о файле
 /// @author     Тузиков Г.А. janisrus35@gmail.com
 
@@ -17,6 +18,7 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <time.h>
+#include <sys/stat.h>
 
 /*
     Макроподстановки
@@ -25,8 +27,23 @@
 /// @brief      Максимальный размер строки fileInfoStruct.targetPtr с учетом \0
 #define FILE_INFO_TARGET_LENGTH_MAX 256
 
-/// @brief      Символ-разделитель полей функци fileInfoToString()
-#define FILE_INFO_TO_STRING_DELIMER '\t'
+/// @brief      Размер буфера коротких колонок fileInfoColumnsStruct
+#define FILE_INFO_COLUMNS_BUFFER_LENGTH 256
+
+/// @brief      Количество одновременно выполняемых запросов функции fileInfoGetBatchAt()
+#define FILE_INFO_BATCH_DEPTH 256
+
+/// @brief      Начальный размер буфера пути к файлу в fileInfoContextStruct
+#define FILE_INFO_PATH_CAPACITY_INITIAL 256
+
+/// @brief      Максимальный размер сокращенного названия месяца с учетом \0
+#define FILE_INFO_MONTH_MAX_LENGTH 32
+
+/// @brief      Максимальный размер начала строки с датой: месяц, день и два пробела
+#define FILE_INFO_TIME_PREFIX_MAX_LENGTH (FILE_INFO_MONTH_MAX_LENGTH + 4)
+
+/// @brief      Количество записей кеша дат
+#define FILE_INFO_TIME_CACHE_SIZE 256
 
 /*
     Перечисления
@@ -46,6 +63,37 @@ typedef enum fileInfoTypesEnum
     fileInfoTypeCount        ///< Количество типов файлов
 }fileInfoTypesEnum;
 
+/// @brief      Перечисление полей информации о файле
+/// @details    Используется в качестве битовой маски для запроса у ядра только необходимых полей
+typedef enum fileInfoFieldsEnum
+{
+    fileInfoFieldType         = 1 << 0,       ///< Тип файла
+    fileInfoFieldAccess       = 1 << 1,       ///< Права доступа
+    fileInfoFieldLinksCount   = 1 << 2,       ///< Количество жестких ссылок
+    fileInfoFieldOwnerId      = 1 << 3,       ///< Id владельца файла
+    fileInfoFieldGroupId      = 1 << 4,       ///< Id группы файла
+    fileInfoFieldSize         = 1 << 5,       ///< Размер файла
+    fileInfoFieldDeviceNumber = 1 << 6,       ///< Номер устройства
+    fileInfoFieldTimeEdit     = 1 << 7,       ///< Время последнего изменения файла
+    fileInfoFieldBlocks       = 1 << 8,       ///< Количество занимаемых файлом 512 байтовых блоков
+    fileInfoFieldAll          = (1 << 9) - 1  ///< Все поля
+}fileInfoFieldsEnum;
+
+/// @brief      Перечисление колонок строкового представления информации о файле
+typedef enum fileInfoColumnsEnum
+{
+    fileInfoColumnType = 0,   ///< Тип файла
+    fileInfoColumnAccess,     ///< Права доступа
+    fileInfoColumnLinksCount, ///< Количество жестких ссылок
+    fileInfoColumnOwner,      ///< Владелец файла
+    fileInfoColumnGroup,      ///< Группа файла
+    fileInfoColumnSize,       ///< Размер файла или номер устройства
+    fileInfoColumnTimeEdit,   ///< Время последнего изменения файла
+    fileInfoColumnFileName,   ///< Имя файла
+    fileInfoColumnTarget,     ///< Имя цели ссылки
+    fileInfoColumnCount       ///< Количество колонок
+}fileInfoColumnsEnum;
+
 /*
     Структуры
 */
@@ -94,8 +142,9 @@ typedef struct fileInfoStruct
     uint32_t             linksCount;     ///< Количество жестких ссылок
     uint32_t             ownerId;        ///< Id владельца файла
     uint32_t             groupId;        ///< Id группы файла
-    int64_t              size;           ///< Размер файла
+    off_t                size;           ///< Размер файла
     time_t               timeEdit;       ///< Время последнего изменения файла
+    long                 timeEditNsec;   ///< Наносекунды времени последнего изменения файла
     char                *fileNamePtr;    ///< Указатель на строку с именем файла
     fileInfoTargetStruct targetInfo;     ///< Информация о цели ссылки
     int64_t              blocks;         ///< Количество занимаемых файлом 512 байтовых блоков
@@ -104,6 +153,33 @@ typedef struct fileInfoStruct
 
 #pragma pack (pop)
 
+/// @brief      Структура контекста получения информации о файле
+/// @details    Хранит результат stat текущего файла и буферы для промежуточных данных.
+///                 Контекст принадлежит вызывающему, поэтому разные потоки
+///                 могут получать информацию о файлах одновременно, каждый со своим контекстом
+/// @note       Обнуленная структура является пустым контекстом
+typedef struct fileInfoContextStruct
+{
+    char        *filePathPtr;                            ///< Путь до текущего файла относительно dirFd
+    size_t       filePathCapacity;                       ///< Размер буфера filePathPtr
+    int          dirFd;                                  ///< Дескриптор директории, относительно которой задан filePathPtr
+    bool         isFileSet;                              ///< Флаг наличия текущего файла
+    struct stat  stat;                                   ///< Результат stat текущего файла
+    char         linkTarget[FILE_INFO_TARGET_LENGTH_MAX]; ///< Буфер для цели символической ссылки
+}fileInfoContextStruct;
+
+/// @brief      Структура строкового представления информации о файле
+/// @details    Каждая колонка задается указателем на строку с \0 и ее длиной.
+///                 Короткие колонки хранятся в buffer, имена владельца и группы указывают
+///                 в кеш idName, имена файла и цели ссылки - в fileInfoStruct
+/// @note       Колонка fileInfoColumnTarget равна 0, если файл не является ссылкой
+typedef struct fileInfoColumnsStruct
+{
+    const char *fieldsList[fileInfoColumnCount];          ///< Указатели на колонки
+    size_t      lengthsList[fileInfoColumnCount];         ///< Длины колонок без \0
+    char        buffer[FILE_INFO_COLUMNS_BUFFER_LENGTH];  ///< Буфер коротких колонок
+}fileInfoColumnsStruct;
+
 /*
     Прототипы функций получения информации о файле
 */
@@ -116,8 +192,17 @@ typedef struct fileInfoStruct
 ///                 В противном случае, возвращает false
 bool fileInfoIsExists(const char *filePtr, bool *isOkPtr);
 
+/// @brief      Функция проверки существования файла относительно директории
+/// @details    Аналог fileInfoIsExists(), в котором относительный filePtr отсчитывается от dirFd
+/// @param[in]  dirFd   Дескриптор директории или AT_FDCWD
+/// @param[in]  filePtr Указатель на файл
+/// @param[out] isOkPtr Указатель на флаг успешного выполнения операции. Может быть равен 0
+/// @return     Возвращает true если файл существует.
+///                 В противном случае, возвращает false
+bool fileInfoIsExistsAt(int dirFd, const char *filePtr, bool *isOkPtr);
+
 /// @brief      Функция получения всей информации о файле filePtr
-/// @details    Данная функция выполняет вызов fileInfoSetActiveFile() с filePtr в качестве аргумента,
+/// @details    Данная функция выполняет вызов fileInfoContextSetFile() с filePtr в качестве аргумента,
 ///                 затем последовательно заполняет структуру fileInfoPtr,
 ///                 выполняя вызовы соответствующих fileInfoGet функций
 /// @param[in]  filePtr      Указатель на путь к файлу
@@ -128,103 +213,173 @@ bool fileInfoIsExists(const char *filePtr, bool *isOkPtr);
 ///                 Не забудьте очистить память при удалении fileInfoPtr, если функция вернула true!
 void fileInfoGet(const char *filePtr, fileInfoStruct *fileInfoPtr, bool isFollowLink, bool *isOkPtr);
 
-/// @brief      Функция установки активного файла
-/// @details    Данная функция выполняет запись filePtr и полученных при помощи lstat() данных в 
-///                 fileInfoPath и fileInfoStat соответственно
+/// @brief      Функция получения всей информации о файле filePtr относительно директории
+/// @details    Аналог fileInfoGet(), в котором относительный filePtr и относительные цели ссылок
+///                 отсчитываются от dirFd. Позволяет передавать имя файла без полного пути,
+///                 не упираясь в PATH_MAX и не разбирая путь к директории для каждого файла
+/// @param[in]  dirFd        Дескриптор директории или AT_FDCWD
+/// @param[in]  filePtr      Указатель на путь к файлу
+/// @param[out] fileInfoPtr  Указатель на информацию о файле
+/// @param[in]  isFollowLink Флаг следования по ссылке до конца
+/// @param[out] isOkPtr      Указатель на флаг успешного выполнения операции. Может быть равен 0
+/// @warning    Для инициализации fileNamePtr и targetInfo.filePathPtr используется malloc!
+///                 Не забудьте очистить память, вызвав fileInfoClear()!
+void fileInfoGetAt(int dirFd, const char *filePtr, fileInfoStruct *fileInfoPtr, bool isFollowLink, bool *isOkPtr);
+
+/// @brief      Функция получения всей информации о файле filePtr с использованием контекста
+/// @details    Аналог fileInfoGetAt(), использующий contextPtr для промежуточных данных.
+///                 Позволяет не выделять буферы заново для каждого файла
+/// @param[in]  contextPtr   Указатель на контекст
+/// @param[in]  dirFd        Дескриптор директории или AT_FDCWD
+/// @param[in]  filePtr      Указатель на путь к файлу
+/// @param[out] fileInfoPtr  Указатель на информацию о файле
+/// @param[in]  isFollowLink Флаг следования по ссылке до конца
+/// @param[out] isOkPtr      Указатель на флаг успешного выполнения операции. Может быть равен 0
+/// @warning    Для инициализации fileNamePtr и targetInfo.filePathPtr используется malloc!
+///                 Не забудьте очистить память, вызвав fileInfoClear()!
+void fileInfoGetContextAt(fileInfoContextStruct *contextPtr, int dirFd, const char *filePtr, fileInfoStruct *fileInfoPtr, bool isFollowLink, bool *isOkPtr);
+
+/// @brief      Функция получения всей информации о группе файлов одной директории
+/// @details    Аналог fileInfoGetAt() для count файлов. Запросы statx отправляются пакетом через io_uring,
+///                 результаты обрабатываются по мере готовности и записываются в fileInfoList
+///                 под тем же индексом, что и имя файла в filesList.
+///                 Если io_uring недоступен, информация получается последовательно через fileInfoGetAt()
+/// @param[in]  dirFd        Дескриптор директории или AT_FDCWD
+/// @param[in]  filesList    Список путей к файлам
+/// @param[out] fileInfoList Список указателей на информацию о файлах
+/// @param[in]  count        Количество файлов
+/// @param[in]  isFollowLink Флаг следования по ссылке до конца
+/// @param[out] isOkPtr      Указатель на флаг успешного выполнения операции. Может быть равен 0
+/// @warning    Для инициализации fileNamePtr и targetInfo.filePathPtr используется malloc!
+///                 Не забудьте очистить память каждого элемента fileInfoList, вызвав fileInfoClear(),
+///                 в том числе в случае ошибки
+void fileInfoGetBatchAt(int dirFd, const char *const *filesList, fileInfoStruct *const *fileInfoList, size_t count, bool isFollowLink, bool *isOkPtr);
+
+/// @brief      Функция очистки информации о файле
+/// @details    Данная функция выполняет освобождение памяти, выделенной fileInfoGet() под
+///                 fileNamePtr и targetInfo.filePathPtr
+/// @param[in]  fileInfoPtr Указатель на информацию о файле. Может быть равен 0
+void fileInfoClear(fileInfoStruct *fileInfoPtr);
+
+/// @brief      Функция установки текущего файла контекста
+/// @details    Данная функция выполняет запись filePtr и полученных при помощи statx() данных в 
+///                 contextPtr->filePathPtr и contextPtr->stat соответственно.
+///                 У ядра запрашиваются только поля из fileInfoFields
 /// @warning    Данная функция использует malloc!
-///                 Не забудьте очистить память при выходе из программы, вызвав функцию fileInfoClearActiveFile()! 
-/// @param[in]  filePtr Указатель на путь к файлу
-/// @return     Возвращает true если задать активный файл как filePtr удалось.
+///                 Не забудьте очистить память, вызвав функцию fileInfoContextClear()! 
+/// @param[in]  contextPtr Указатель на контекст
+/// @param[in]  filePtr    Указатель на путь к файлу
+/// @return     Возвращает true если задать текущий файл как filePtr удалось.
+///                 В противном случае, возвращает false
+bool fileInfoContextSetFile(fileInfoContextStruct *contextPtr, const char *filePtr);
+
+/// @brief      Функция установки текущего файла контекста относительно директории
+/// @details    Аналог fileInfoContextSetFile(), в котором относительный filePtr отсчитывается от dirFd.
+///                 dirFd должен оставаться открытым, пока файл установлен
+/// @param[in]  contextPtr Указатель на контекст
+/// @param[in]  dirFd      Дескриптор директории или AT_FDCWD
+/// @param[in]  filePtr    Указатель на путь к файлу
+/// @return     Возвращает true если задать текущий файл как filePtr удалось.
 ///                 В противном случае, возвращает false
-bool fileInfoSetActiveFile(const char *filePtr);
+bool fileInfoContextSetFileAt(fileInfoContextStruct *contextPtr, int dirFd, const char *filePtr);
 
-/// @brief      Функция сброса активного файла
-/// @details    Данная функция выполняет сброс активного файла и очистку занятых ресурсов
-void fileInfoClearActiveFile(void);
+/// @brief      Функция очистки контекста
+/// @details    Данная функция выполняет сброс текущего файла и очистку занятых контекстом ресурсов
+/// @param[in]  contextPtr Указатель на контекст. Может быть равен 0
+void fileInfoContextClear(fileInfoContextStruct *contextPtr);
 
 /// @brief      Функция получения типа файла
-/// @details    Данная функция выполняет получения типа активного файла
+/// @details    Данная функция выполняет получения типа текущего файла контекста
+/// @param[in]  contextPtr Указатель на контекст
 /// @param[out] isOkPtr Указатель на флаг успешного выполнения операции. Может быть равен 0
-/// @return     Возвращает тип активного файла
-fileInfoTypesEnum fileInfoGetType(bool *isOkPtr);
+/// @return     Возвращает тип текущего файла контекста
+fileInfoTypesEnum fileInfoGetType(const fileInfoContextStruct *contextPtr, bool *isOkPtr);
 
 /// @brief      Функция получения прав доступа файла
-/// @details    Данная функция выполняет получения прав доступа активного файла
+/// @details    Данная функция выполняет получения прав доступа текущего файла контекста
+/// @param[in]  contextPtr Указатель на контекст
 /// @param[out] isOkPtr Указатель на флаг успешного выполнения операции. Может быть равен 0
-/// @return     Возвращает прав доступа активного файла
-fileInfoAccessStruct fileInfoGetAccess(bool *isOkPtr);
+/// @return     Возвращает прав доступа текущего файла контекста
+fileInfoAccessStruct fileInfoGetAccess(const fileInfoContextStruct *contextPtr, bool *isOkPtr);
 
 /// @brief      Функция получения количества жестких ссылок на файл
-/// @details    Данная функция выполняет получение количества жестких ссылок на активный файл
+/// @details    Данная функция выполняет получение количества жестких ссылок на текущий файл контекста
+/// @param[in]  contextPtr Указатель на контекст
 /// @param[out] isOkPtr Указатель на флаг успешного выполнения операции. Может быть равен 0
-/// @return     Возвращает количество жестких ссылок на активный файл
-uint32_t fileInfoGetLinksCount(bool *isOkPtr);
+/// @return     Возвращает количество жестких ссылок на текущий файл контекста
+uint32_t fileInfoGetLinksCount(const fileInfoContextStruct *contextPtr, bool *isOkPtr);
 
 /// @brief      Функция получения Id владельца файла
-/// @details    Данная функция выполняет получение Id владельца активного файла
+/// @details    Данная функция выполняет получение Id владельца текущего файла контекста
+/// @param[in]  contextPtr Указатель на контекст
 /// @param[out] isOkPtr Указатель на флаг успешного выполнения операции. Может быть равен 0
-/// @return     Возвращает Id владельца активного файла
-uint32_t fileInfoGetOwnerId(bool *isOkPtr);
+/// @return     Возвращает Id владельца текущего файла контекста
+uint32_t fileInfoGetOwnerId(const fileInfoContextStruct *contextPtr, bool *isOkPtr);
 
 /// @brief      Функция получения Id группы файла
-/// @details    Данная функция выполняет получение Id группы активного файла
+/// @details    Данная функция выполняет получение Id группы текущего файла контекста
+/// @param[in]  contextPtr Указатель на контекст
 /// @param[out] isOkPtr Указатель на флаг успешного выполнения операции. Может быть равен 0
-/// @return     Возвращает Id группы активного файла
-uint32_t fileInfoGetGroupId(bool *isOkPtr);
+/// @return     Возвращает Id группы текущего файла контекста
+uint32_t fileInfoGetGroupId(const fileInfoContextStruct *contextPtr, bool *isOkPtr);
 
 /// @brief      Функция получения размера файла
-/// @details    Данная функция выполняет получение размера активного файла
+/// @details    Данная функция выполняет получение размера текущего файла контекста
+/// @param[in]  contextPtr Указатель на контекст
 /// @param[out] isOkPtr Указатель на флаг успешного выполнения операции. Может быть равен 0
-/// @return     Возвращает размер активного файла
-uint32_t fileInfoGetSize(bool *isOkPtr);
+/// @return     Возвращает размер текущего файла контекста
+off_t fileInfoGetSize(const fileInfoContextStruct *contextPtr, bool *isOkPtr);
 
 /// @brief      Функция получения номера устройства
-/// @details    Данная функция выполняет получение номера устройства активного файла
+/// @details    Данная функция выполняет получение номера устройства текущего файла контекста
+/// @param[in]  contextPtr Указатель на контекст
 /// @param[out] isOkPtr Указатель на флаг успешного выполнения операции. Может быть равен 0
-/// @return     Возвращает номер устройства активного файла
-__uint64_t fileInfoGetDeviceNumber(bool *isOkPtr);
+/// @return     Возвращает номер устройства текущего файла контекста
+__uint64_t fileInfoGetDeviceNumber(const fileInfoContextStruct *contextPtr, bool *isOkPtr);
 
-/// @brief      Функция получения размера файла
-/// @details    Данная функция выполняет получение размера активного файла
+/// @brief      Функция получения времени изменения файла
+/// @details    Данная функция выполняет получение времени последнего изменения текущего файла контекста
+/// @param[in]  contextPtr Указатель на контекст
 /// @param[out] isOkPtr Указатель на флаг успешного выполнения операции. Может быть равен 0
-/// @return     Возвращает размер активного файла
-uint32_t fileInfoGetSize(bool *isOkPtr);
+/// @return     Возвращает время изменения текущего файла контекста
+time_t fileInfoGetTimeEdit(const fileInfoContextStruct *contextPtr, bool *isOkPtr);
 
-/// @brief      Функция получения времени изменения файла
-/// @details    Данная функция выполняет получение времени последнего изменения активного файла
+/// @brief      Функция получения наносекунд времени изменения файла
+/// @details    Данная функция выполняет получение наносекунд времени последнего изменения текущего файла контекста
+/// @param[in]  contextPtr Указатель на контекст
 /// @param[out] isOkPtr Указатель на флаг успешного выполнения операции. Может быть равен 0
-/// @return     Возвращает время изменения активного файла
-time_t fileInfoGetTimeEdit(bool *isOkPtr);
+/// @return     Возвращает наносекунды времени изменения текущего файла контекста
+long fileInfoGetTimeEditNsec(const fileInfoContextStruct *contextPtr, bool *isOkPtr);
 
 /// @brief      Функция получения цели символической ссылки
 /// @details    Данная функция выполняет чтение цели символической ссылки и записывает ее в строку stringPtr длинной stringLength
+/// @param[in]  contextPtr    Указатель на контекст
 /// @param[out] stringPtr     Указатель на строку, куда будет записан результат с \0
 /// @param[in]  stringLength  Длина строки stringPtr
 /// @param[out] isOkPtr       Указатель на флаг успешного выполнения операции. Может быть равен 0
 /// @return     Возвращает длинну stringPtr
-size_t fileInfoGetLinkTarget(char *stringPtr, size_t stringLength, bool *isOkPtr);
+size_t fileInfoGetLinkTarget(const fileInfoContextStruct *contextPtr, char *stringPtr, size_t stringLength, bool *isOkPtr);
 
 /// @brief      Функция получения количества занимаемых блоков
-/// @details    Данная функция выполняет получение количества занимаемых активным файлом 512 байтовых блоков
+/// @details    Данная функция выполняет получение количества занимаемых текущим файлом контекста 512 байтовых блоков
+/// @param[in]  contextPtr Указатель на контекст
 /// @param[out] isOkPtr Указатель на флаг успешного выполнения операции. Может быть равен 0
-/// @return     Возвращает количество занимаемых активным файлом блоков
-uint32_t fileInfoGet512BytesBlocks(bool *isOkPtr);
+/// @return     Возвращает количество занимаемых текущим файлом контекста блоков
+uint32_t fileInfoGet512BytesBlocks(const fileInfoContextStruct *contextPtr, bool *isOkPtr);
 
 /*
     Прототипы функций получения строкового представления информации о файле
 */
 
 /// @brief      Функция получения строкового представления всей информации о файле
-/// @details    Данная функция выполняет запись fileInfoPtr в строку stringPtr длинной stringLength,
-///                 выполняя вызовы соответствующих fileInfoToString функций.
-///                 Порядок информации в stringPtr соответствует порядку полей в fileInfoPtr.
-///                 Разделителем полей является FILE_INFO_TO_STRING_DELIMER
-/// @param[in]  fileInfoPtr  Указатель на информацию о файле
-/// @param[out] stringPtr    Указатель на строку, куда будет записан результат с \0
-/// @param[in]  stringLength Длина строки stringPtr
-/// @param[out] isOkPtr      Указатель на флаг успешного выполнения операции. Может быть равен 0
-/// @return     Возвращает длинну stringPtr
-size_t fileInfoToString(const fileInfoStruct *fileInfoPtr, char *stringPtr, size_t stringLength, bool *isOkPtr);
+/// @details    Данная функция выполняет заполнение колонок columnsPtr по fileInfoPtr,
+///                 выполняя вызовы соответствующих fileInfoToString функций
+/// @param[in]  fileInfoPtr Указатель на информацию о файле
+/// @param[out] columnsPtr  Указатель на структуру колонок
+/// @warning    Колонки ссылаются на fileInfoPtr и кеш idName, поэтому действительны,
+///                 пока не очищены fileInfoPtr и кеш имен
+/// @param[out] isOkPtr     Указатель на флаг успешного выполнения операции. Может быть равен 0
+void fileInfoToColumns(const fileInfoStruct *fileInfoPtr, fileInfoColumnsStruct *columnsPtr, bool *isOkPtr);
 
 /// @brief      Функция получения строкового представления типа файла
 /// @details    Данная функция выполняет запись type в строку stringPtr длинной stringLength
@@ -237,15 +392,15 @@ size_t fileInfoToString(const fileInfoStruct *fileInfoPtr, char *stringPtr, size
 size_t fileInfoToStringType(fileInfoTypesEnum type, char *stringPtr, size_t stringLength, bool *isOkPtr);
 
 /// @brief      Функция получения строкового представления структуры доступа к файлу
-/// @details    Данная функция выполняет запись accessPtr в строку stringPtr длинной stringLength
+/// @details    Данная функция выполняет запись accessPtr в строку stringPtr длинной stringLength.
+///                 Строка берется из заранее построенной таблицы на все 4096 сочетаний прав
 /// @param[in]  accessPtr    Указатель на структуру доступа к файлу
-/// @param[in]  type         Тип файла
 /// @param[out] stringPtr    Указатель на строку, куда будет записан результат с \0
 /// @warning    Длина stringPtr должна быть хотя бы 10 байт. 9 на биты доступа и 1 под \0
 /// @param[in]  stringLength Длина строки stringPtr
 /// @param[out] isOkPtr      Указатель на флаг успешного выполнения операции. Может быть равен 0
 /// @return     Возвращает длинну stringPtr
-size_t fileInfoToStringAccess(const fileInfoAccessStruct *accessPtr, fileInfoTypesEnum type, char *stringPtr, size_t stringLength, bool *isOkPtr);
+size_t fileInfoToStringAccess(const fileInfoAccessStruct *accessPtr, char *stringPtr, size_t stringLength, bool *isOkPtr);
 
 /// @brief      Функция получения строкового количества жестких ссылок на файл
 /// @details    Данная функция выполняет запись linksCount в строку stringPtr длинной stringLength
@@ -257,7 +412,8 @@ size_t fileInfoToStringAccess(const fileInfoAccessStruct *accessPtr, fileInfoTyp
 size_t fileInfoToStringLinksCount(uint32_t linksCount, char *stringPtr, size_t stringLength, bool *isOkPtr);
 
 /// @brief      Функция получения строкового представления Id владельца файла
-/// @details    Данная функция выполняет перевод ownerId в строку stringPtr длинной stringLength
+/// @details    Данная функция выполняет перевод ownerId в строку stringPtr длинной stringLength.
+///                 Имя пользователя берется из кеша idNameGetUser()
 /// @param[in]  ownerId      Id владельца файла
 /// @param[out] stringPtr    Указатель на строку, куда будет записан результат с \0
 /// @param[in]  stringLength Длина строки stringPtr
@@ -266,7 +422,8 @@ size_t fileInfoToStringLinksCount(uint32_t linksCount, char *stringPtr, size_t s
 size_t fileInfoToStringOwnerId(uint32_t ownerId, char *stringPtr, size_t stringLength, bool *isOkPtr);
 
 /// @brief      Функция получения строкового представления Id группы файла
-/// @details    Данная функция выполняет перевод groupId в строку stringPtr длинной stringLength
+/// @details    Данная функция выполняет перевод groupId в строку stringPtr длинной stringLength.
+///                 Имя группы берется из кеша idNameGetGroup()
 /// @param[in]  groupId      Id группы файла
 /// @param[out] stringPtr    Указатель на строку, куда будет записан результат с \0
 /// @param[in]  stringLength Длина строки stringPtr
@@ -281,7 +438,7 @@ size_t fileInfoToStringGroupId(uint32_t groupId, char *stringPtr, size_t stringL
 /// @param[in]  stringLength Длина строки stringPtr
 /// @param[out] isOkPtr      Указатель на флаг успешного выполнения операции. Может быть равен 0
 /// @return     Возвращает длинну stringPtr
-size_t fileInfoToStringSize(uint32_t size, char *stringPtr, size_t stringLength, bool *isOkPtr);
+size_t fileInfoToStringSize(off_t size, char *stringPtr, size_t stringLength, bool *isOkPtr);
 
 /// @brief      Функция получения строкового размера файла
 /// @details    Данная функция выполняет запись size в строку stringPtr длинной stringLength
@@ -293,7 +450,10 @@ size_t fileInfoToStringSize(uint32_t size, char *stringPtr, size_t stringLength,
 size_t fileInfoToStringDeviceNumber(__uint64_t deviceNumber, char *stringPtr, size_t stringLength, bool *isOkPtr);
 
 /// @brief      Функция получения строкового представления времени последнего изменения файла
-/// @details    Данная функция выполняет перевод timeEdit в строку stringPtr длинной stringLength
+/// @details    Данная функция выполняет перевод timeEdit в строку stringPtr длинной stringLength.
+///                 Текущее время запрашивается один раз за время работы программы, поэтому граница
+///                 в полгода одинакова для всех файлов. Месяц и день берутся из кеша по суткам,
+///                 названия месяцев вычисляются один раз
 /// @param[in]  timeEdit     Время последнего изменения файла
 /// @param[out] stringPtr    Указатель на строку, куда будет записан результат с \0
 /// @param[in]  stringLength Длина строки stringPtr
@@ -301,5 +461,21 @@ size_t fileInfoToStringDeviceNumber(__uint64_t deviceNumber, char *stringPtr, si
 /// @return     Возвращает длинну stringPtr
 size_t fileInfoToStringTimeEdit(time_t timeEdit, char *stringPtr, size_t stringLength, bool *isOkPtr);
 
+/*
+    Переменные
+*/
+
+/// @brief      Битовая маска полей из fileInfoFieldsEnum, запрашиваемых у ядра
+/// @details    Поля, отсутствующие в маске, могут быть не заполнены. 
+///                 Это позволяет не запрашивать, например, количество блоков, если оно не выводится
+/// @note       По умолчанию равна fileInfoFieldAll
+extern uint32_t fileInfoFields;
+
+/// @brief      Флаг запроса информации о файле без синхронизации с сервером
+/// @details    Если установлен, statx() вызывается с флагом AT_STATX_DONT_SYNC.
+///                 На сетевых файловых системах это позволяет использовать закешированные атрибуты
+/// @note       По умолчанию выключен
+extern bool fileInfoIsDontSyncEnabled;
+
 // _FILE_INFO_H_
 #endif
\ No newline at end of file
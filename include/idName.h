@@ -0,0 +1,80 @@
+/// @file       idName.h
+/// @brief      Файл с объявлениями модуля получения имен пользователей и групп
+/// @details    Модуль кеширует соответствие uid и gid именам на все время работы программы,
+///                 поэтому NSS запрашивается не более одного раза для каждого id.
+///                 Если в nsswitch.conf первым источником пользователей или групп указан files,
+///                 /etc/passwd и /etc/group разбираются напрямую и NSS запрашивается только
+///                 для id, отсутствующих в этих файлах.
+///                 Вместе с именем хранится его длина. Функции модуля потокобезопасны. <br>
+///                 Порядок работы с модулем: <br>
+///                 1) idNameGetUser() и idNameGetGroup() для получения имени пользователя и группы <br>
+///                 2) idNameClear() для очистки кеша
+/// @author     Тузиков Г.А. janisrus35@gmail.com
+
+#ifndef _ID_NAME_H_
+#define _ID_NAME_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/*
+    Макроподстановки
+*/
+
+/// @brief      Начальная вместимость таблицы имен
+/// @note       Должна быть степенью двойки
+#define ID_NAME_TABLE_CAPACITY_INITIAL 64
+
+/// @brief      Размер буфера на стеке для getpwuid_r() и getgrgid_r()
+#define ID_NAME_NSS_BUFFER_SIZE 1024
+
+/// @brief      Путь к файлу настройки NSS
+#define ID_NAME_NSSWITCH_PATH "/etc/nsswitch.conf"
+
+/// @brief      Путь к файлу пользователей
+#define ID_NAME_PASSWD_PATH "/etc/passwd"
+
+/// @brief      Путь к файлу групп
+#define ID_NAME_GROUP_PATH "/etc/group"
+
+/*
+    Прототипы функций
+*/
+
+/// @brief      Функция получения имени пользователя
+/// @details    Данная функция выполняет поиск имени пользователя uid в кеше.
+///                 Если имени в кеше нет, оно запрашивается у NSS и добавляется в кеш.
+///                 Если пользователь не найден, именем считается десятичная запись uid
+/// @param[in]  uid       Id пользователя
+/// @param[out] lengthPtr Указатель на длину имени без \0. Может быть равен 0
+/// @param[out] isOkPtr   Указатель на флаг успешного выполнения операции. Может быть равен 0
+/// @return     Возвращает указатель на имя пользователя, действительный до вызова idNameClear().
+///                 В случае ошибки возвращает 0
+const char *idNameGetUser(uint32_t uid, size_t *lengthPtr, bool *isOkPtr);
+
+/// @brief      Функция получения имени группы
+/// @details    Аналог idNameGetUser() для групп
+/// @param[in]  gid       Id группы
+/// @param[out] lengthPtr Указатель на длину имени без \0. Может быть равен 0
+/// @param[out] isOkPtr   Указатель на флаг успешного выполнения операции. Может быть равен 0
+/// @return     Возвращает указатель на имя группы, действительный до вызова idNameClear().
+///                 В случае ошибки возвращает 0
+const char *idNameGetGroup(uint32_t gid, size_t *lengthPtr, bool *isOkPtr);
+
+/// @brief      Функция очистки кеша имен
+/// @details    Данная функция выполняет освобождение памяти, занятой кешем имен пользователей и групп
+void idNameClear(void);
+
+/*
+    Переменные
+*/
+
+/// @brief      Флаг прямого разбора /etc/passwd и /etc/group
+/// @details    Если установлен, файлы разбираются при первом обращении к кешу,
+///                 когда это не меняет результат по сравнению с NSS
+/// @note       По умолчанию включен
+extern bool idNameIsFilesParserEnabled;
+
+// _ID_NAME_H_
+#endif
@@ -2,15 +2,30 @@
 /// @brief      Файл с объявлениями модуля вывода данных о файле или содержимым директории
 /// @details    Порядок работы с модулем: <br>
 ///                 1) jls() для сбора и вывода информации о файле/файлах в директории <br>
-///                 2) jlsPrintFileInfo() для вывода информации о файле <br>
-///                 3) jlsGetCommonInfo() для получения общей информации о файлах в директории <br>
-///                 4) jlsGetFilesList() для получения списка файлов в директории <br>
-///                 5) jlsSortFilesList() для сортировки списка файлов <br>
-///                 6) jlsCountFilesInDirectory() для подсчета количества файлов в директории <br>
-///                 7) jlsCalculateAlignment() для расчета максимальных размеров полей информации о файле <br>
+///                 2) jlsPrintFiles() для вывода информации о файлах из списка <br>
+///                 3) jlsPrintFileInfo() для вывода информации о файле <br>
+///                 4) jlsGetCommonInfo() для получения общей информации о файлах в директории <br>
+///                 5) jlsGetFilesList() для получения списка файлов в директории <br>
+///                 6) jlsFilesListAppend() для добавления информации о файле в список файлов <br>
+///                 7) jlsFilesListClear() для очистки списка файлов <br>
+///                 8) jlsSortFilesList() для сортировки списка файлов <br>
+///                 9) jlsCalculateAlignment() для расчета максимальных размеров полей информации о файле <br>
+///                 10) jlsPrintDirStream() для потокового вывода директории без сортировки <br>
+///                 11) jlsSortSpecParse() для разбора описания сортировки <br>
+///                 12) jlsPrintDirTop() для вывода первых jlsTopCount файлов директории <br>
 /// @note       Для настройки вывода, модулем используются следующие переменные: <br>
 ///                 1) jlsIsSafeModeEnabled <br>
 ///                 2) jlsIsColorModeEnabled <br>
+///                 3) jlsDirBufferSize <br>
+///                 4) jlsStatBatchThreshold <br>
+///                 5) jlsStatThreadsCount <br>
+///                 6) jlsStatParallelThreshold <br>
+///                 7) jlsIsStreamModeEnabled <br>
+///                 8) jlsStreamLookahead <br>
+///                 9) jlsSortParallelThreshold <br>
+///                 10) jlsSortSpec <br>
+///                 11) jlsSortOrder <br>
+///                 12) jlsTopCount <br>
 /// @author     Тузиков Г.А. janisrus35@gmail.com
 
 #ifndef _JLS_H_
@@ -20,13 +35,35 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "color.h"
+#include "fileInfo.h"
 
 /*
     Макроподстановки
 */
 
-/// @brief      Максимальная длина строки со всей информацией о файле
-#define JLS_FILE_INFO_MAX_LENGTH 500
+/// @brief      Начальная вместимость списка файлов
+#define JLS_FILES_LIST_CAPACITY_INITIAL 64
+
+/// @brief      Количество файлов в директории, начиная с которого информация о них запрашивается пакетно
+#define JLS_STAT_BATCH_THRESHOLD_DEFAULT 64
+
+/// @brief      Количество файлов в директории, начиная с которого информация о них запрашивается в нескольких потоках
+#define JLS_STAT_PARALLEL_THRESHOLD_DEFAULT 1024
+
+/// @brief      Количество файлов, которое поток забирает на обработку за один раз
+#define JLS_STAT_CHUNK_SIZE 64
+
+/// @brief      Максимальное количество потоков получения информации о файлах
+#define JLS_STAT_THREADS_MAX 64
+
+/// @brief      Количество файлов, читаемых из директории наперед в потоковом режиме
+#define JLS_STREAM_LOOKAHEAD_DEFAULT 256
+
+/// @brief      Количество файлов, начиная с которого список файлов сортируется в нескольких потоках
+#define JLS_SORT_PARALLEL_THRESHOLD_DEFAULT 32768
+
+/// @brief      Максимальное количество полей в описании сортировки
+#define JLS_SORT_FIELDS_MAX 4
 
 /*
     Перечисления
@@ -49,6 +86,17 @@ typedef enum jlsSafeTypesEnum
     jlsSafeTypeBoth   = 3  ///< Безопасный режим нужен и для имени файла и для цели ссылки
 }jlsSafeTypesEnum;
 
+/// @brief      Перечисление полей сортировки
+typedef enum jlsSortFieldsEnum
+{
+    jlsSortFieldName,      ///< Имя файла, по возрастанию
+    jlsSortFieldTimeEdit,  ///< Время последнего изменения файла, сначала новые
+    jlsSortFieldSize,      ///< Размер файла, сначала большие
+    jlsSortFieldExtension, ///< Расширение файла, начиная с последней точки, по возрастанию
+    jlsSortFieldVersion,   ///< Имя файла в естественном порядке: числа в имени сравниваются по значению
+    jlsSortFieldCount      ///< Количество полей сортировки
+}jlsSortFieldsEnum;
+
 /*
     Структуры
 */
@@ -65,10 +113,13 @@ typedef struct jlsAlignmentStruct
 }jlsAlignmentStruct;
 
 /// @brief      Стуктура списка файлов
+/// @details    Каждый элемент списка содержит информацию о файле, полученную однократно при сканировании.
+///                 Эта информация используется и при расчете выравнивания, и при выводе
 typedef struct jlsFilesListStruct
 {
-    char **list;  ///< Список файлов
-    size_t count; ///< Количество файлов
+    fileInfoStruct **list;     ///< Список информации о файлах
+    size_t           count;    ///< Количество файлов
+    size_t           capacity; ///< Вместимость списка файлов
 }jlsFilesListStruct;
 
 /// @brief      Структура общей информации о файле/файлах в директории
@@ -80,6 +131,15 @@ typedef struct jlsCommonInfoStruct
     uint64_t           total;     ///< Количество занимаемых файлами 1024 байтовых блоков
 }jlsCommonInfoStruct;
 
+/// @brief      Структура описания сортировки
+/// @details    Файлы сравниваются по полям в порядке их следования. При равенстве всех полей файлы сравниваются по имени
+typedef struct jlsSortSpecStruct
+{
+    jlsSortFieldsEnum fieldsList[JLS_SORT_FIELDS_MAX];     ///< Список полей сортировки
+    bool              isReversedList[JLS_SORT_FIELDS_MAX]; ///< Список флагов обратного порядка полей
+    size_t            count;                               ///< Количество полей. Если равно 0, файлы не сортируются
+}jlsSortSpecStruct;
+
 #pragma pack (pop)
 
 /*
@@ -98,10 +158,18 @@ typedef struct jlsCommonInfoStruct
 ///                 В противном случае, возвращет 1
 int jls(const char *filePtr, const jlsAlignmentStruct *alignmentPtr, jlsSafeTypesEnum safeType);
 
+/// @brief      Функция вывода информации о файлах из списка
+/// @details    Данная функция выполняет подготовку цветов и последовательный вывод информации
+///                 о каждом файле из filesListPtr без повторного получения информации о нем
+/// @param[in]  filesListPtr Указатель на список файлов
+/// @param[in]  alignmentPtr Указатель на структуру максимальных размеров полей информации о файле. Может быть равен 0
+/// @param[in]  safeType     Тип безопасного режима
+/// @param[out] isOkPtr      Указатель на флаг успешного выполнения операции. Может быть равен 0
+void jlsPrintFiles(const jlsFilesListStruct *filesListPtr, const jlsAlignmentStruct *alignmentPtr, jlsSafeTypesEnum safeType, bool *isOkPtr);
+
 /// @brief      Функция вывода информации о файле
-/// @details    Данная функция выпоняет вывод fileInfoStringPtr с учетом значений из alignmentPtr
-/// @param[in]  fileInfoStringPtr Указатель на строку с информацией о файле
-/// @warning    Строка fileInfoStringPtr должна соответствовать строке, получаемой при помощи fileInfoToString()
+/// @details    Данная функция выпоняет вывод колонок columnsPtr с учетом значений из alignmentPtr
+/// @param[in]  columnsPtr        Указатель на колонки информации о файле, полученные при помощи fileInfoToColumns()
 /// @param[in]  alignmentPtr      Указатель на структуру максимальных размеров полей информации о файле
 /// @param[in]  safeType          Тип безопасного режима
 /// @note       Можно отключить при помощи сброса jlsIsSafeModeEnabled
@@ -109,10 +177,31 @@ int jls(const char *filePtr, const jlsAlignmentStruct *alignmentPtr, jlsSafeType
 /// @note       Можно отключить при помощи сброса jlsIsColorModeEnabled
 /// @param[out] isOkPtr           Указатель на флаг успешного выполнения операции. Может быть равен 0
 /// @note       Указатель alignmentPtr может быть равен 0
-void jlsPrintFileInfo(const char *fileInfoStringPtr, const jlsAlignmentStruct *alignmentPtr, jlsSafeTypesEnum safeType, const colorFileTargetStruct *colorsPtr, bool *isOkPtr);
+void jlsPrintFileInfo(const fileInfoColumnsStruct *columnsPtr, const jlsAlignmentStruct *alignmentPtr, jlsSafeTypesEnum safeType, const colorFileTargetStruct *colorsPtr, bool *isOkPtr);
+
+/// @brief      Функция потокового вывода информации о файлах в директории
+/// @details    Данная функция выполняет чтение директории порциями по jlsStreamLookahead файлов
+///                 и вывод каждой порции сразу после получения информации о ней, без сортировки.
+///                 Память не зависит от количества файлов в директории.
+///                 Ширина полей рассчитывается по уже прочитанным порциям и только растет.
+///                 Количество занимаемых блоков (total) не выводится
+/// @param[in]  dirPtr  Указатель на директорию
+/// @param[out] isOkPtr Указатель на флаг успешного выполнения операции. Может быть равен 0
+void jlsPrintDirStream(const char *dirPtr, bool *isOkPtr);
+
+/// @brief      Функция вывода первых jlsTopCount файлов директории в порядке jlsSortSpec и jlsSortOrder
+/// @details    Данная функция выполняет чтение директории порциями и отбор файлов в пирамиду из jlsTopCount элементов
+///                 без сортировки всей директории. Память зависит только от jlsTopCount.
+///                 Если порядок зависит только от имен, информация запрашивается только об отобранных файлах.
+///                 Ширина полей рассчитывается только по выводимым файлам.
+///                 Количество занимаемых блоков (total) не выводится
+/// @param[in]  dirPtr  Указатель на директорию
+/// @param[out] isOkPtr Указатель на флаг успешного выполнения операции. Может быть равен 0
+void jlsPrintDirTop(const char *dirPtr, bool *isOkPtr);
 
 /// @brief      Функция получения общей информациии о файлах в директории
 /// @details    Данная функция выполняет получение общей информации о файлах в директории
+///                 за один проход по директории
 /// @note       Список информации:<br>
 ///                 1) Список файлов<br>
 ///                 2) Максимальный размер полей информации о файлах<br>
@@ -124,69 +213,89 @@ void jlsPrintFileInfo(const char *fileInfoStringPtr, const jlsAlignmentStruct *a
 jlsCommonInfoStruct jlsGetCommonInfo(const char *dirPtr, bool *isOkPtr);
 
 /// @brief      Функция получения списка файлов в указанной директории
-/// @details    Данная функция выполняет последовательное формирование списка файлов, игнорируя . и ..
+/// @details    Данная функция выполняет последовательное формирование списка файлов за один проход по директории, игнорируя . и ..
+///                 Для каждого файла однократно выполняется fileInfoGet()
 /// @warning    Данная функция использует malloc!
-///                 Не забудьте очистить память при выходе из программы, очистив каждый элемент списка и сам список! 
+///                 Не забудьте очистить память, вызвав jlsFilesListClear()! 
 /// @param[in]  dirPtr  Указатель на директорию
 /// @param[out] isOkPtr Указатель на флаг успешного выполнения операции. Может быть равен 0
 /// @return     Возвращает список файлов в указанной директории
 jlsFilesListStruct jlsGetFilesList(const char *dirPtr, bool *isOkPtr);
 
+/// @brief      Функция добавления информации о файле в конец списка файлов
+/// @details    Данная функция выполняет запись fileInfoPtr в конец filesListPtr.
+///                 Если места в списке недостаточно, его вместимость увеличивается вдвое
+/// @note       В случае успешного выполнения владельцем fileInfoPtr становится filesListPtr
+/// @param[in]  filesListPtr Указатель на список файлов
+/// @param[in]  fileInfoPtr  Указатель на информацию о файле, выделенную при помощи malloc
+/// @param[out] isOkPtr      Указатель на флаг успешного выполнения операции. Может быть равен 0
+void jlsFilesListAppend(jlsFilesListStruct *filesListPtr, fileInfoStruct *fileInfoPtr, bool *isOkPtr);
+
+/// @brief      Функция очистки списка файлов
+/// @details    Данная функция выполняет освобождение памяти, занятой каждым элементом списка и самим списком
+/// @param[in]  filesListPtr Указатель на список файлов. Может быть равен 0
+void jlsFilesListClear(jlsFilesListStruct *filesListPtr);
+
 /// @brief      Функция сортировки списка файлов
-/// @details    Данная функция выполняет сортировку filesListPtr по sort
+/// @details    Данная функция выполняет сортировку filesListPtr по полям specPtr в порядке sort.
+///                 Поля каждого файла однократно собираются в один ключ, который сравнивается memcmp():
+///                 числа записываются в порядке от старшего байта, строки преобразуются strxfrm().
+///                 В локалях C и POSIX ключи сортируются поразрядной сортировкой по байтам.
+///                 Списки от jlsSortParallelThreshold файлов сортируются в нескольких потоках
 /// @param[in]  filesListPtr Указатель на список файлов
-/// @param[in]  sort         Тип сортировки
+/// @param[in]  specPtr      Указатель на описание сортировки. Если равен 0, файлы сортируются по имени
+/// @param[in]  sort         Тип сортировки. jlsSortDescend меняет итоговый порядок на обратный
 /// @param[out] isOkPtr      Указатель на флаг успешного выполнения операции. Может быть равен 0
-void jlsSortFilesList(jlsFilesListStruct *filesListPtr, jlsSortEnum sort, bool *isOkPtr);
+void jlsSortFilesList(jlsFilesListStruct *filesListPtr, const jlsSortSpecStruct *specPtr, jlsSortEnum sort, bool *isOkPtr);
 
-/// @brief      Функция подсчета количества файлов в директории
-/// @details    Данная функция выполняет последовательный подсчет количества файлов в директории, игнорируя . и .. 
-/// @param[in]  dirPtr  Указатель на директорию
-/// @param[out] isOkPtr Указатель на флаг успешного выполнения операции. Может быть равен 0
-/// @return     Возвращает количество файлов в директории
-size_t jlsCountFilesInDirectory(const char *dirPtr, bool *isOkPtr);
+/// @brief      Функция разбора описания сортировки
+/// @details    Описание - список полей через запятую: name, mtime, size, extension, version.
+///                 Минус перед полем меняет порядок этого поля на обратный.
+///                 Описание none означает вывод файлов в порядке чтения директории
+/// @param[in]  stringPtr Указатель на строку описания, например "mtime,-size,name"
+/// @param[out] specPtr   Указатель на описание сортировки
+/// @param[out] isOkPtr   Указатель на флаг успешного выполнения операции. Может быть равен 0
+void jlsSortSpecParse(const char *stringPtr, jlsSortSpecStruct *specPtr, bool *isOkPtr);
 
 /// @brief      Функция расчета максимальных размеров полей информации о файле
-/// @details    Данная функция выполняет последовательное получение информации о файлах, 
-///                 получение строкового представления этой информации и расчет длины каждого поля информации о файле.
+/// @details    Данная функция выполняет получение строкового представления информации о файлах
+///                 и расчет длины каждого поля информации о файле.
 ///                 Если какое то поле превысило прошлый максимум этого поля, он будет обновлен
-/// @param[in]  pathPtr   Указатель на директорию с файлами
-/// @param[in]  filesList Список файлов в указанной директории
+/// @param[in]  filesList Список файлов
 /// @param[out] isOkPtr   Указатель на флаг успешного выполнения операции. Может быть равен 0
 /// @return    Возвращает структуру с максимальными размерами всех полей информации о файле
-jlsAlignmentStruct jlsCalculateAlignment(const char *pathPtr, const jlsFilesListStruct *filesList, bool *isOkPtr);
+jlsAlignmentStruct jlsCalculateAlignment(const jlsFilesListStruct *filesList, bool *isOkPtr);
 
 /// @brief      Функция вычисления безопасного режима
 /// @details    Данная функция выполняет проверку всех имен файлов и целей ссылок.
 ///                 В зависимости от того, что из них требует вывода одинарных кавычек,
 ///                 возвращает нужный для их отображения безопасный режим
-/// @param[in]  pathPtr   Указатель на директорию с файлами
-/// @param[in]  filesList Список файлов в указанной директории
+/// @param[in]  filesList Список файлов
 /// @param[out] isOkPtr   Указатель на флаг успешного выполнения операции. Может быть равен 0
 /// @return     Возвращает необходимый для отображения filesList безопасный режим
-jlsSafeTypesEnum jlsCalculateSafeType(const char *pathPtr, const jlsFilesListStruct *filesList, bool *isOkPtr);
+jlsSafeTypesEnum jlsCalculateSafeType(const jlsFilesListStruct *filesList, bool *isOkPtr);
 
 /// @brief      Функция расчета количества занимаемых файлами 1024 байтовых блоков
-/// @details    Данная функция выполняет последовательное получение информации о 
-///                 количестве занимаемых файлами 512 байтовых блоках,
-///                 суммирует эти значения и делит пополам
-/// @param[in]  pathPtr   Указатель на директорию с файлами
-/// @param[in]  filesList Список файлов в указанной директории
+/// @details    Данная функция выполняет суммирование количества занимаемых файлами 512 байтовых блоков
+///                 и делит эту сумму пополам
+/// @param[in]  filesList Список файлов
 /// @param[out] isOkPtr   Указатель на флаг успешного выполнения операции. Может быть равен 0
 /// @return    Возвращает количество занимаемых файлами 1024 байтовых блоков 
-uint64_t jlsCalculate1024ByteBlocks(const char *pathPtr, const jlsFilesListStruct *filesList, bool *isOkPtr);
+uint64_t jlsCalculate1024ByteBlocks(const jlsFilesListStruct *filesList, bool *isOkPtr);
 
 /// @brief      Функция преобразования строки в безопасный вариант
 /// @details    Данная функция выполняет экранирование строки stringPtr по правилам: <br>
 ///                 -) Если небезопасных символов нет, ничего не делать <br>
 ///                 -) Если есть одинарные кавычки, экранировать stringPtr двойными кавычками <br>
 ///                 -) Если одинарных кавычек нет, экранировать stringPtr одинарными кавычками <br>
-///                 Новая строка записывается в safePtr
+///                 Если есть одинарные кавычки и один из символов "$`\, экранировать stringPtr одинарными кавычками,
+///                     заменив каждую одинарную кавычку на '\'' <br>
+///                 Новая строка записывается в safePtr за один проход по stringPtr
 /// @param[in]  stringPtr     Указатель на строку
 /// @param[out] safePtr       Указатель на строку в безопасном варианте, куда будет записан результат с \0
 /// @param[in]  safePtrLength Длина safePtrLength
 /// @param[out] isOkPtr       Указатель на флаг успешного выполнения операции. Может быть равен 0
-/// @return    Возвращает количество записанных в safePtr данных
+/// @return     Возвращает длину записанной в safePtr строки без \0
 size_t jlsMakeStringSafe(const char *stringPtr, char *safePtr, size_t safePtrLength, bool *isOkPtr);
 
 /*
@@ -203,5 +312,59 @@ extern bool jlsIsSafeModeEnabled;
 /// @note       По умолчанию выключен
 extern bool jlsIsColorModeEnabled;
 
+/// @brief      Размер буфера для чтения записей директории
+/// @details    Чем больше буфер, тем меньше системных вызовов требуется для чтения больших директорий
+/// @note       По умолчанию равен DIR_READER_BUFFER_SIZE_DEFAULT
+extern size_t jlsDirBufferSize;
+
+/// @brief      Количество файлов в директории, начиная с которого информация о них запрашивается пакетно
+/// @details    Для директорий с количеством файлов не меньше порога используется fileInfoGetBatchAt().
+///                 Для маленьких директорий создание кольца io_uring обходится дороже, чем сами запросы
+/// @note       По умолчанию равен JLS_STAT_BATCH_THRESHOLD_DEFAULT
+extern size_t jlsStatBatchThreshold;
+
+/// @brief      Количество потоков получения информации о файлах и сортировки
+/// @details    Если равно 0, используется количество доступных процессоров, но не более JLS_STAT_THREADS_MAX.
+///                 Если равно 1, информация о файлах запрашивается и сортируется в одном потоке
+/// @note       По умолчанию равно 0
+extern size_t jlsStatThreadsCount;
+
+/// @brief      Количество файлов в директории, начиная с которого информация о них запрашивается в нескольких потоках
+/// @details    Файлы раздаются потокам порциями по JLS_STAT_CHUNK_SIZE.
+///                 Порядок файлов в списке от количества потоков не зависит
+/// @note       По умолчанию равно JLS_STAT_PARALLEL_THRESHOLD_DEFAULT
+extern size_t jlsStatParallelThreshold;
+
+/// @brief      Флаг потокового вывода директорий
+/// @details    Если установлен, jls() выводит директории при помощи jlsPrintDirStream():
+///                 без сортировки, без total и сразу по мере чтения
+/// @note       По умолчанию выключен
+extern bool jlsIsStreamModeEnabled;
+
+/// @brief      Количество файлов, читаемых из директории наперед в потоковом режиме
+/// @details    Чем больше значение, тем точнее ширина полей и тем позже выводится первая строка
+/// @note       По умолчанию равно JLS_STREAM_LOOKAHEAD_DEFAULT
+extern size_t jlsStreamLookahead;
+
+/// @brief      Количество файлов, начиная с которого список файлов сортируется в нескольких потоках
+/// @details    Части списка сортируются независимо и объединяются параллельным слиянием.
+///                 Количество потоков задается jlsStatThreadsCount
+/// @note       По умолчанию равно JLS_SORT_PARALLEL_THRESHOLD_DEFAULT
+extern size_t jlsSortParallelThreshold;
+
+/// @brief      Описание сортировки директорий
+/// @note       По умолчанию файлы сортируются по имени
+extern jlsSortSpecStruct jlsSortSpec;
+
+/// @brief      Порядок сортировки директорий
+/// @details    jlsSortDescend меняет итоговый порядок на обратный
+/// @note       По умолчанию равен jlsSortAscend
+extern jlsSortEnum jlsSortOrder;
+
+/// @brief      Количество выводимых файлов директории
+/// @details    Если не равно 0, jls() выводит директории при помощи jlsPrintDirTop()
+/// @note       По умолчанию равно 0
+extern size_t jlsTopCount;
+
 // _JLS_H_
 #endif
\ No newline at end of file
@@ -0,0 +1,81 @@
+/// @file       output.h
+/// @brief      Файл с объявлениями модуля буферизированного вывода
+/// @details    Модуль накапливает вывод в большом буфере и записывает его в STDOUT_FILENO
+///                 при помощи write() и writev() крупными блоками, минуя stdio.
+///                 Ошибка записи запоминается и возвращается outputFlush(). <br>
+///                 Порядок работы с модулем: <br>
+///                 1) Функции с префиксом outputWrite для добавления данных в буфер <br>
+///                 2) outputNewLine() для завершения строки <br>
+///                 3) outputFlush() для записи буфера
+/// @note       Для настройки вывода, модулем используются следующие переменные: <br>
+///                 1) outputIsLineFlushEnabled
+/// @warning    Функции модуля не потокобезопасны
+/// @author     Тузиков Г.А. janisrus35@gmail.com
+
+#ifndef _OUTPUT_H_
+#define _OUTPUT_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+
+/*
+    Макроподстановки
+*/
+
+/// @brief      Размер буфера вывода
+#define OUTPUT_BUFFER_SIZE (64 * 1024)
+
+/*
+    Прототипы функций
+*/
+
+/// @brief      Функция добавления данных в буфер вывода
+/// @details    Данная функция выполняет копирование dataPtr в буфер вывода.
+///                 Если данные не помещаются в буфер, буфер записывается вместе с ними одним writev()
+/// @param[in]  dataPtr Указатель на данные
+/// @param[in]  length  Длина данных
+/// @return     Возвращает length
+size_t outputWrite(const char *dataPtr, size_t length);
+
+/// @brief      Функция добавления строки в буфер вывода
+/// @param[in]  stringPtr Указатель на строку с \0
+/// @return     Возвращает длину строки
+size_t outputWriteString(const char *stringPtr);
+
+/// @brief      Функция добавления символа в буфер вывода
+/// @param[in]  symbol Символ
+/// @return     Возвращает 1
+size_t outputWriteChar(char symbol);
+
+/// @brief      Функция добавления выровненной строки в буфер вывода
+/// @details    Данная функция выполняет добавление stringPtr, дополненной пробелами до width символов.
+///                 Аналог printf("%*s") и printf("%-*s")
+/// @param[in]  stringPtr       Указатель на строку
+/// @param[in]  length          Длина строки
+/// @param[in]  width           Ширина поля
+/// @param[in]  isLeftAligned   Флаг выравнивания по левому краю
+/// @return     Возвращает количество добавленных байт
+size_t outputWritePadded(const char *stringPtr, size_t length, size_t width, bool isLeftAligned);
+
+/// @brief      Функция завершения строки
+/// @details    Данная функция выполняет добавление \n в буфер вывода.
+///                 Если установлен outputIsLineFlushEnabled, буфер записывается
+void outputNewLine(void);
+
+/// @brief      Функция записи буфера вывода
+/// @param[out] isOkPtr Указатель на флаг успешного выполнения операции. Может быть равен 0
+/// @note       Сбрасывается, если запись этого или любого предыдущего буфера завершилась ошибкой
+void outputFlush(bool *isOkPtr);
+
+/*
+    Переменные
+*/
+
+/// @brief      Флаг записи буфера после каждой строки
+/// @details    Устанавливается, если вывод производится в терминал, чтобы строки появлялись сразу.
+///                 При выводе в файл или канал буфер записывается только при заполнении
+/// @note       По умолчанию выключен
+extern bool outputIsLineFlushEnabled;
+
+// _OUTPUT_H_
+#endif
@@ -0,0 +1,99 @@
+/// @file       statRing.h
+/// @brief      Файл с объявлениями модуля пакетного получения информации о файлах через io_uring
+/// @details    Модуль выполняет запросы statx через кольцо io_uring, что позволяет
+///                 держать в ядре одновременно много запросов и получать результаты
+///                 без отдельного системного вызова на каждый файл.
+///                 Системные вызовы io_uring выполняются напрямую, без liburing. <br>
+///                 Порядок работы с модулем: <br>
+///                 1) statRingOpen() для создания кольца <br>
+///                 2) statRingPrepareStatx() для постановки запросов в очередь <br>
+///                 3) statRingSubmit() для отправки запросов в ядро и ожидания результатов <br>
+///                 4) statRingReap() для получения результатов выполненных запросов <br>
+///                 5) statRingClose() для удаления кольца
+/// @author     Тузиков Г.А. janisrus35@gmail.com
+
+#ifndef _STAT_RING_H_
+#define _STAT_RING_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/*
+    Структуры
+*/
+
+struct statx;
+
+/// @brief      Структура кольца io_uring
+typedef struct statRingStruct
+{
+    int           fd;            ///< Дескриптор кольца
+    unsigned int  depth;         ///< Количество элементов очереди запросов
+    unsigned int  pendingCount;  ///< Количество подготовленных, но не отправленных запросов
+    void         *sqRingPtr;     ///< Отображение очереди запросов
+    size_t        sqRingSize;    ///< Размер sqRingPtr
+    void         *cqRingPtr;     ///< Отображение очереди результатов. Может совпадать с sqRingPtr
+    size_t        cqRingSize;    ///< Размер cqRingPtr
+    void         *sqesPtr;       ///< Отображение массива запросов
+    size_t        sqesSize;      ///< Размер sqesPtr
+    unsigned int *sqHeadPtr;     ///< Указатель на начало очереди запросов
+    unsigned int *sqTailPtr;     ///< Указатель на конец очереди запросов
+    unsigned int *sqMaskPtr;     ///< Указатель на маску индексов очереди запросов
+    unsigned int *sqArrayPtr;    ///< Указатель на массив индексов запросов
+    unsigned int *cqHeadPtr;     ///< Указатель на начало очереди результатов
+    unsigned int *cqTailPtr;     ///< Указатель на конец очереди результатов
+    unsigned int *cqMaskPtr;     ///< Указатель на маску индексов очереди результатов
+    void         *cqesPtr;       ///< Указатель на массив результатов
+}statRingStruct;
+
+/*
+    Прототипы функций
+*/
+
+/// @brief      Функция создания кольца
+/// @details    Данная функция выполняет создание кольца io_uring на depth запросов
+///                 и проверяет, что ядро поддерживает операцию statx
+/// @warning    Не забудьте удалить кольцо, вызвав statRingClose()!
+/// @param[out] ringPtr Указатель на кольцо
+/// @param[in]  depth   Количество одновременно выполняемых запросов
+/// @param[out] isOkPtr Указатель на флаг успешного выполнения операции. Может быть равен 0.
+///                 Равен false, если io_uring или statx через io_uring недоступны
+void statRingOpen(statRingStruct *ringPtr, unsigned int depth, bool *isOkPtr);
+
+/// @brief      Функция постановки запроса statx в очередь
+/// @warning    filePtr и resultPtr должны оставаться действительными до получения результата запроса
+/// @param[in]  ringPtr   Указатель на кольцо
+/// @param[in]  dirFd     Дескриптор директории, относительно которой задан filePtr, или AT_FDCWD
+/// @param[in]  filePtr   Указатель на путь к файлу
+/// @param[in]  flags     Флаги statx
+/// @param[in]  mask      Маска полей statx
+/// @param[out] resultPtr Указатель на результат statx
+/// @param[in]  userData  Значение, возвращаемое statRingReap() вместе с результатом запроса
+/// @return     Возвращает true, если запрос поставлен в очередь.
+///                 Если очередь заполнена, возвращает false
+bool statRingPrepareStatx(statRingStruct *ringPtr, int dirFd, const char *filePtr, int flags, unsigned int mask, struct statx *resultPtr, uint64_t userData);
+
+/// @brief      Функция отправки запросов в ядро
+/// @details    Данная функция выполняет отправку всех подготовленных запросов
+///                 и ожидание выполнения не менее waitCount запросов
+/// @param[in]  ringPtr   Указатель на кольцо
+/// @param[in]  waitCount Количество запросов, выполнение которых необходимо дождаться
+/// @param[out] isOkPtr   Указатель на флаг успешного выполнения операции. Может быть равен 0
+void statRingSubmit(statRingStruct *ringPtr, unsigned int waitCount, bool *isOkPtr);
+
+/// @brief      Функция получения результата выполненного запроса
+/// @param[in]  ringPtr     Указатель на кольцо
+/// @param[out] userDataPtr Указатель на значение userData запроса
+/// @param[out] resultPtr   Указатель на результат запроса: 0 или -errno
+/// @return     Возвращает true, если результат получен.
+///                 Если выполненных запросов нет, возвращает false
+bool statRingReap(statRingStruct *ringPtr, uint64_t *userDataPtr, int32_t *resultPtr);
+
+/// @brief      Функция удаления кольца
+/// @warning    Перед удалением кольца необходимо получить результаты всех отправленных запросов
+/// @param[in]  ringPtr Указатель на кольцо. Может быть равен 0
+void statRingClose(statRingStruct *ringPtr);
+
+// _STAT_RING_H_
+#endif
@@ -0,0 +1,105 @@
+/// @file       arena.c
+/// @brief      См. arena.h
+/// @author     Тузиков Г.А. janisrus35@gmail.com
+
+#include "arena.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+    Функции
+*/
+
+void *arenaAlloc(arenaStruct *arenaPtr, size_t size, bool *isOkPtr)
+{
+    bool isOk = true;
+
+    if (!isOkPtr)
+    {
+        isOkPtr = &isOk;
+    }
+
+    *isOkPtr = true;
+
+    if (!arenaPtr)
+    {
+        *isOkPtr = false;
+        return 0;
+    }
+
+    // Округление вверх до ARENA_ALIGNMENT
+    size = (size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+
+    arenaBlockStruct *blockPtr = arenaPtr->blockPtr;
+
+    if (!blockPtr || blockPtr->size - blockPtr->used < size)
+    {
+        size_t blockSize = size > ARENA_BLOCK_SIZE_MIN ? size : ARENA_BLOCK_SIZE_MIN;
+
+        blockPtr = malloc(sizeof(arenaBlockStruct) + blockSize);
+        if (!blockPtr)
+        {
+            *isOkPtr = false;
+            return 0;
+        }
+
+        blockPtr->nextPtr = arenaPtr->blockPtr;
+        blockPtr->size    = blockSize;
+        blockPtr->used    = 0;
+
+        arenaPtr->blockPtr = blockPtr;
+    }
+
+    void *answer = &blockPtr->data[blockPtr->used];
+
+    blockPtr->used += size;
+
+    return answer;
+}
+
+char *arenaStringCopy(arenaStruct *arenaPtr, const char *stringPtr, size_t stringLength, bool *isOkPtr)
+{
+    bool isOk = true;
+
+    if (!isOkPtr)
+    {
+        isOkPtr = &isOk;
+    }
+
+    *isOkPtr = true;
+
+    if (!stringPtr)
+    {
+        *isOkPtr = false;
+        return 0;
+    }
+
+    char *answer = 0;
+
+    answer = arenaAlloc(arenaPtr, stringLength + 1, isOkPtr);
+    if (!*isOkPtr)
+    {
+        return 0;
+    }
+
+    memcpy(answer, stringPtr, stringLength);
+    answer[stringLength] = '\0';
+
+    return answer;
+}
+
+void arenaClear(arenaStruct *arenaPtr)
+{
+    if (!arenaPtr)
+    {
+        return;
+    }
+
+    while (arenaPtr->blockPtr)
+    {
+        arenaBlockStruct *nextPtr = arenaPtr->blockPtr->nextPtr;
+
+        free(arenaPtr->blockPtr);
+        arenaPtr->blockPtr = nextPtr;
+    }
+}
@@ -3,51 +3,101 @@
 /// @author     Тузиков Г.А. janisrus35@gmail.com
 
 #include "color.h"
+#include "arena.h"
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 
 /*
     Внутренние структуры
 */
 
-#pragma pack (push, 1)
-
-/// @brief      Структура цвета
+/// @brief      Структура цвета по умолчанию
 typedef struct colorStruct
 {
-    char key[COLOR_KEY_MAX_LENGTH];   ///< Ключ
-    char ansi[COLOR_ANSI_MAX_LENGTH]; ///< ANSI последовательность
+    const char *key;  ///< Ключ
+    const char *ansi; ///< ANSI последовательность
 }colorStruct;
 
-#pragma pack (pop)
+/// @brief      Структура цвета расширения файла
+typedef struct colorExtensionStruct
+{
+    const char     *suffixPtr;    ///< Суффикс имени файла, например ".tar"
+    size_t          suffixLength; ///< Длина suffixPtr без \0
+    colorESCStruct  esc;          ///< Escape-последовательность
+}colorExtensionStruct;
+
+/// @brief      Структура узла дерева суффиксов
+/// @details    Дерево строится по перевернутым суффиксам, поэтому поиск идет от конца имени файла.
+///                 Дети узла хранятся односвязным списком. Индекс 0 - корень, поэтому 0 в
+///                 childIndex и siblingIndex означает отсутствие узла
+typedef struct colorTrieNodeStruct
+{
+    uint32_t childIndex;     ///< Индекс первого ребенка
+    uint32_t siblingIndex;   ///< Индекс следующего брата
+    uint32_t extensionIndex; ///< Индекс в colorExtensionsList суффикса, заканчивающегося в узле. COLOR_TRIE_NONE, если нет
+    char     symbol;         ///< Символ ребра, ведущего в узел
+}colorTrieNodeStruct;
+
+/*
+    Внутренние макроподстановки
+*/
+
+/// @brief      Отсутствие суффикса в узле дерева суффиксов
+#define COLOR_TRIE_NONE UINT32_MAX
 
 /*
     Прототипы внутренних функций
 */
 
-/// @brief      Функция получения ключа, соответствующего информации о файле
+/// @brief      Функция разбора одной записи LS_COLORS
+/// @details    Разбор повторяет strtok_r() по '=': пустые поля пропускаются,
+///                 ключом считается первое поле, Ansi кодом - второе
+/// @param[in]  entryPtr      Указатель на запись вида "key=ansi"
+/// @param[in]  entryLength   Длина записи
+/// @param[in]  isTypeSetList Список флагов заданных в LS_COLORS ключей типов файлов
+/// @param[out] isOkPtr       Указатель на флаг успешного выполнения операции
+static void colorParseEntry(const char *entryPtr, size_t entryLength, bool *isTypeSetList, bool *isOkPtr);
+
+/// @brief      Функция построения escape-последовательности
+/// @details    Данная функция выполняет запись "\033[" ansi "m" в colorArena
+/// @param[out] escPtr     Указатель на escape-последовательность
+/// @param[in]  ansiPtr    Указатель на Ansi код
+/// @param[in]  ansiLength Длина ansiPtr
+/// @param[out] isOkPtr    Указатель на флаг успешного выполнения операции
+static void colorSetESC(colorESCStruct *escPtr, const char *ansiPtr, size_t ansiLength, bool *isOkPtr);
+
+/// @brief      Функция добавления суффикса в дерево суффиксов
+/// @param[in]  extensionIndex Индекс суффикса в colorExtensionsList
+/// @note       Если такой суффикс уже есть, сохраняется более ранний
+/// @param[out] isOkPtr        Указатель на флаг успешного выполнения операции
+static void colorTrieInsert(uint32_t extensionIndex, bool *isOkPtr);
+
+/// @brief      Функция поиска цвета расширения файла
+/// @details    Данная функция выполняет проход по дереву суффиксов от конца имени файла.
+///                 Из всех совпавших суффиксов выбирается самый ранний в LS_COLORS
+/// @param[in]  fileNamePtr    Указатель на имя файла
+/// @param[in]  fileNameLength Длина имени файла
+/// @return     Возвращает индекс в colorExtensionsList или COLOR_TRIE_NONE, если суффикс не найден
+static uint32_t colorTrieFind(const char *fileNamePtr, size_t fileNameLength);
+
+/// @brief      Функция получения escape-последовательности, соответствующей информации о файле
 /// @param[in]  fileNamePtr    Указатель на имя файла
 /// @param[in]  type           Тип файла
 /// @param[in]  accessPtr      Указатель на права доступа файла
 /// @param[in]  isTargetExists Флаг существования цели символической ссылки
-/// @return     Возвращает ключ, соответствующий информации о файле.
-///                 Если при вычислении ключа произошла ошибка, возвращает 0
-static const char *colorGetKey(const char *fileNamePtr, fileInfoTypesEnum type, const fileInfoAccessStruct *accessPtr, bool isTargetExists);
-
-/// @brief      Функция получения Ansi кода, соответствующего key из colorList
-/// @param[in]  key Ключ из colorList
-/// @note       Если key отсутсвует в colorList, будет произведен поиск в colorListDefault
-/// @return     Возвращает Ansi код, соответствующий key из colorList.
-///                 Если при поиске Ansi кода произошла ошибка, возвращает 0
-static const char *colorGetAnsi(const char *key);
+/// @return     Возвращает escape-последовательность, соответствующую информации о файле.
+///                 Если при вычислении произошла ошибка, возвращает 0
+static const colorESCStruct *colorGetESC(const char *fileNamePtr, fileInfoTypesEnum type, const fileInfoAccessStruct *accessPtr, bool isTargetExists);
 
 /*
     Внутренние переменные
 */
 
 /// @brief      Список цветов по умолчанию
-const colorStruct colorListDefault[] = 
+/// @note       Индекс соответствует colorKeysEnum
+const colorStruct colorListDefault[colorKeyCount] =
 {
     { "fi", "0"     }, // Обычный файл
     { "no", "0"     }, // Обычный файл
@@ -71,14 +121,35 @@ const colorStruct colorListDefault[] =
     { "ex", "01;32" }, // Исполняемый файл
 };
 
-/// @brief      Количество элементов в списке цветов по умолчанию
-const size_t colorListDefaultCount = sizeof(colorListDefault) / sizeof(colorListDefault[0]);
+/// @brief      Пустая escape-последовательность на случай нехватки памяти
+const colorESCStruct colorESCEmpty = {"", 0, true};
+
+/// @brief      Арена для escape-последовательностей и суффиксов
+arenaStruct colorArena = {0};
+
+/// @brief      Escape-последовательности типов файлов. Индекс соответствует colorKeysEnum
+colorESCStruct colorTypesList[colorKeyCount] = {0};
 
-/// @brief      Список цветов
-colorStruct colorList[COLOR_KEY_MAX_COUNT] = {0};
+/// @brief      Список цветов расширений в порядке LS_COLORS
+colorExtensionStruct *colorExtensionsList = 0;
 
-/// @brief      Количество элементов в списке цветов
-size_t colorListCount = 0;
+/// @brief      Количество элементов colorExtensionsList
+size_t colorExtensionsCount = 0;
+
+/// @brief      Вместимость colorExtensionsList
+size_t colorExtensionsCapacity = 0;
+
+/// @brief      Дерево суффиксов расширений
+colorTrieNodeStruct *colorTrieList = 0;
+
+/// @brief      Количество узлов colorTrieList
+size_t colorTrieCount = 0;
+
+/// @brief      Вместимость colorTrieList
+size_t colorTrieCapacity = 0;
+
+/// @brief      Флаг построенной таблицы цветов
+bool colorIsColorsListReady = false;
 
 /*
     Функции
@@ -86,80 +157,95 @@ size_t colorListCount = 0;
 
 bool colorUpdateColorsList(void)
 {
-    colorStruct newColorsList[COLOR_KEY_MAX_COUNT] = {0};
-    
-    char *env = getenv("LS_COLORS");
+    bool answer = true;
+    bool isOk   = true;
+
+    bool isTypeSetList[colorKeyCount] = {0};
+
+    arenaClear(&colorArena);
+    colorExtensionsCount = 0;
+    colorTrieCount       = 0;
+
+    const char *env = getenv("LS_COLORS");
     if (!env)
     {
-        return false;
+        answer = false;
     }
-    
-    char *keyANSIPtr  = 0;
-    char *colonSave   = 0;
-    
-    size_t currentColor = 0;
 
-    keyANSIPtr = strtok_r(env, ":", &colonSave);
-    while (keyANSIPtr)
+    // LS_COLORS не изменяется, поэтому записи разбираются по указателям, а не strtok_r()
+    while (env && *env)
     {
-        const char *key  = 0;
-        const char *ansi = 0;
-        
-        char *equealsSave = 0;
+        const char *entryEnd = strchr(env, ':');
+        if (!entryEnd)
+        {
+            entryEnd = env + strlen(env);
+        }
 
-        key = strtok_r(keyANSIPtr, "=", &equealsSave);
-        if (key)
+        colorParseEntry(env, entryEnd - env, &isTypeSetList[0], &isOk);
+        if (!isOk)
         {
-            ansi = strtok_r(NULL, "=", &equealsSave);
-            if (!ansi)
-            {
-                for (int i = 0; i < colorListDefaultCount; ++i)
-                {
-                    if (strcmp(&colorListDefault[i].key[0], key) == 0)
-                    {
-                        ansi = &colorListDefault[i].ansi[0];
-                        break;
-                    }
-                }
-            }
+            break;
         }
-        
-        if (key && ansi)
+
+        env = *entryEnd ? entryEnd + 1 : entryEnd;
+    }
+
+    // При нехватке памяти таблица строится заново по цветам по умолчанию
+    if (!isOk)
+    {
+        answer = false;
+        isOk   = true;
+
+        arenaClear(&colorArena);
+        colorExtensionsCount = 0;
+        colorTrieCount       = 0;
+        memset(&isTypeSetList[0], 0, sizeof(isTypeSetList));
+    }
+
+    for (size_t i = 0; i < colorKeyCount; ++i)
+    {
+        if (isTypeSetList[i])
         {
-            strcpy(&newColorsList[currentColor].key[0],  key);
-            strcpy(&newColorsList[currentColor].ansi[0], ansi);
-            ++currentColor;
+            continue;
         }
-        
-        if (currentColor == COLOR_KEY_MAX_COUNT)
+
+        colorSetESC(&colorTypesList[i], colorListDefault[i].ansi, strlen(colorListDefault[i].ansi), &isOk);
+        if (!isOk)
         {
-            break;
+            colorTypesList[i] = colorESCEmpty;
+            answer = false;
         }
-        
-        keyANSIPtr = strtok_r(NULL, ":", &colonSave);
     }
 
-    memcpy(&colorList[0], &newColorsList[0], currentColor * sizeof(colorStruct));
-    colorListCount = currentColor;
+    const colorESCStruct *resetPtr = &colorTypesList[colorKeyReset];
 
-    return true;
-}
+    #define IS_RESET(ESC) ((ESC).length == resetPtr->length && memcmp((ESC).stringPtr, resetPtr->stringPtr, resetPtr->length) == 0)
 
-const char *colorGetReset(void)
-{
-    static char reset[COLOR_ESC_MAX_LENGTH] = {0};
+    for (size_t i = 0; i < colorKeyCount; ++i)
+    {
+        colorTypesList[i].isReset = IS_RESET(colorTypesList[i]);
+    }
 
-    const char *ansi = colorGetAnsi("rs");
+    for (size_t i = 0; i < colorExtensionsCount; ++i)
+    {
+        colorExtensionsList[i].esc.isReset = IS_RESET(colorExtensionsList[i].esc);
+    }
+
+    #undef IS_RESET
+
+    colorIsColorsListReady = true;
 
-    int answer = 0;
+    return answer;
+}
 
-    answer = snprintf(&reset[0], COLOR_ESC_MAX_LENGTH, "\033[%sm", ansi);
-    if (answer < 0)
+const colorESCStruct *colorGetReset(void)
+{
+    if (!colorIsColorsListReady)
     {
-        return 0;
+        colorUpdateColorsList();
     }
-    
-    return &reset[0];
+
+    return &colorTypesList[colorKeyReset];
 }
 
 colorFileTargetStruct colorFileToESC(const fileInfoStruct *fileInfoPtr, bool *isOkPtr)
@@ -179,21 +265,15 @@ colorFileTargetStruct colorFileToESC(const fileInfoStruct *fileInfoPtr, bool *is
         return (colorFileTargetStruct){0};
     }
 
-    colorFileTargetStruct answer = {0};
-
-    const char *key  = 0;
-    const char *ansi = 0;
-    
-    key  = colorGetKey(fileInfoPtr->fileNamePtr, fileInfoPtr->type, &fileInfoPtr->access, fileInfoPtr->targetInfo.isTargetExists);
-    ansi = colorGetAnsi(key);
-
-    if (!key || !ansi)
+    if (!colorIsColorsListReady)
     {
-        *isOkPtr = false;
-        return (colorFileTargetStruct){0};
+        colorUpdateColorsList();
     }
 
-    if (snprintf(answer.file, COLOR_ESC_MAX_LENGTH, "\033[%sm", ansi) < 0)
+    colorFileTargetStruct answer = {0};
+
+    answer.filePtr = colorGetESC(fileInfoPtr->fileNamePtr, fileInfoPtr->type, &fileInfoPtr->access, fileInfoPtr->targetInfo.isTargetExists);
+    if (!answer.filePtr)
     {
         *isOkPtr = false;
         return (colorFileTargetStruct){0};
@@ -201,16 +281,8 @@ colorFileTargetStruct colorFileToESC(const fileInfoStruct *fileInfoPtr, bool *is
 
     if (fileInfoPtr->type == fileInfoTypeLink && fileInfoPtr->targetInfo.isTargetExists)
     {
-        key  = colorGetKey(fileInfoPtr->targetInfo.fileNamePtr, fileInfoPtr->targetInfo.type, &fileInfoPtr->targetInfo.access, fileInfoPtr->targetInfo.isTargetExists);
-        ansi = colorGetAnsi(key);
-        
-        if (!key || !ansi)
-        {
-            *isOkPtr = false;
-            return (colorFileTargetStruct){0};
-        }
-
-        if (snprintf(answer.target, COLOR_ESC_MAX_LENGTH, "\033[%sm", ansi) < 0)
+        answer.targetPtr = colorGetESC(fileInfoPtr->targetInfo.fileNamePtr, fileInfoPtr->targetInfo.type, &fileInfoPtr->targetInfo.access, fileInfoPtr->targetInfo.isTargetExists);
+        if (!answer.targetPtr)
         {
             *isOkPtr = false;
             return (colorFileTargetStruct){0};
@@ -218,9 +290,9 @@ colorFileTargetStruct colorFileToESC(const fileInfoStruct *fileInfoPtr, bool *is
     }
     else
     {
-        memcpy(&answer.target, &answer.file, COLOR_ESC_MAX_LENGTH);
+        answer.targetPtr = answer.filePtr;
     }
-    
+
     return answer;
 }
 
@@ -228,7 +300,142 @@ colorFileTargetStruct colorFileToESC(const fileInfoStruct *fileInfoPtr, bool *is
     Внутренние функции
 */
 
-static const char *colorGetKey(const char *fileNamePtr, fileInfoTypesEnum type, const fileInfoAccessStruct *accessPtr, bool isTargetExists)
+static void colorParseEntry(const char *entryPtr, size_t entryLength, bool *isTypeSetList, bool *isOkPtr)
+{
+    *isOkPtr = true;
+
+    const char *entryEnd = entryPtr + entryLength;
+
+    while (entryPtr < entryEnd && *entryPtr == '=')
+    {
+        ++entryPtr;
+    }
+
+    const char *keyPtr = entryPtr;
+
+    while (entryPtr < entryEnd && *entryPtr != '=')
+    {
+        ++entryPtr;
+    }
+
+    size_t keyLength = entryPtr - keyPtr;
+
+    while (entryPtr < entryEnd && *entryPtr == '=')
+    {
+        ++entryPtr;
+    }
+
+    const char *ansiPtr = entryPtr;
+
+    while (entryPtr < entryEnd && *entryPtr != '=')
+    {
+        ++entryPtr;
+    }
+
+    size_t ansiLength = entryPtr - ansiPtr;
+
+    if (!keyLength)
+    {
+        return;
+    }
+
+    if (keyLength == 2)
+    {
+        for (size_t i = 0; i < colorKeyCount; ++i)
+        {
+            if (memcmp(keyPtr, colorListDefault[i].key, 2) != 0)
+            {
+                continue;
+            }
+
+            if (isTypeSetList[i])
+            {
+                return;
+            }
+
+            if (!ansiLength)
+            {
+                ansiPtr    = colorListDefault[i].ansi;
+                ansiLength = strlen(ansiPtr);
+            }
+
+            colorSetESC(&colorTypesList[i], ansiPtr, ansiLength, isOkPtr);
+            if (!*isOkPtr)
+            {
+                return;
+            }
+
+            isTypeSetList[i] = true;
+            return;
+        }
+    }
+
+    // Расширения без Ansi кода не имеют цвета по умолчанию и пропускаются
+    if (keyLength < 2 || keyPtr[0] != '*' || keyPtr[1] != '.' || !ansiLength)
+    {
+        return;
+    }
+
+    if (colorExtensionsCount == colorExtensionsCapacity)
+    {
+        size_t                newCapacity = colorExtensionsCapacity ? colorExtensionsCapacity * 2 : 64;
+        colorExtensionStruct *newListPtr  = realloc(colorExtensionsList, newCapacity * sizeof(colorExtensionStruct));
+        if (!newListPtr)
+        {
+            *isOkPtr = false;
+            return;
+        }
+
+        colorExtensionsList     = newListPtr;
+        colorExtensionsCapacity = newCapacity;
+    }
+
+    colorExtensionStruct *extensionPtr = &colorExtensionsList[colorExtensionsCount];
+
+    extensionPtr->suffixLength = keyLength - 1;
+    extensionPtr->suffixPtr    = arenaStringCopy(&colorArena, keyPtr + 1, extensionPtr->suffixLength, isOkPtr);
+    if (!*isOkPtr)
+    {
+        return;
+    }
+
+    colorSetESC(&extensionPtr->esc, ansiPtr, ansiLength, isOkPtr);
+    if (!*isOkPtr)
+    {
+        return;
+    }
+
+    colorTrieInsert((uint32_t)colorExtensionsCount, isOkPtr);
+    if (!*isOkPtr)
+    {
+        return;
+    }
+
+    ++colorExtensionsCount;
+}
+
+static void colorSetESC(colorESCStruct *escPtr, const char *ansiPtr, size_t ansiLength, bool *isOkPtr)
+{
+    *isOkPtr = true;
+
+    size_t  length    = strlen("\033[") + ansiLength + strlen("m");
+    char   *stringPtr = arenaAlloc(&colorArena, length + 1, isOkPtr);
+    if (!*isOkPtr)
+    {
+        return;
+    }
+
+    memcpy(stringPtr, "\033[", 2);
+    memcpy(&stringPtr[2], ansiPtr, ansiLength);
+    stringPtr[length - 1] = 'm';
+    stringPtr[length]     = '\0';
+
+    escPtr->stringPtr = stringPtr;
+    escPtr->length    = length;
+    escPtr->isReset   = false;
+}
+
+static const colorESCStruct *colorGetESC(const char *fileNamePtr, fileInfoTypesEnum type, const fileInfoAccessStruct *accessPtr, bool isTargetExists)
 {
     if (!fileNamePtr || !accessPtr)
     {
@@ -239,31 +446,31 @@ static const char *colorGetKey(const char *fileNamePtr, fileInfoTypesEnum type,
     {
         if (!isTargetExists)
         {
-            return "or";
+            return &colorTypesList[colorKeyOrphan];
         }
 
-        return "ln";
+        return &colorTypesList[colorKeyLink];
     }
 
     switch (type)
     {
-        case fileInfoTypeSock:  
+        case fileInfoTypeSock:
         {
-            return "so";
+            return &colorTypesList[colorKeySock];
         }
-        case fileInfoTypeFIFO:  
+        case fileInfoTypeFIFO:
         {
-            return "pi";
+            return &colorTypesList[colorKeyFIFO];
         }
-        case fileInfoTypeBlock: 
+        case fileInfoTypeBlock:
         {
-            return "bd";
+            return &colorTypesList[colorKeyBlock];
         }
-        case fileInfoTypeChar:  
+        case fileInfoTypeChar:
         {
-            return "cd";
+            return &colorTypesList[colorKeyChar];
         }
-        default: 
+        default:
         {
             break;
         }
@@ -276,95 +483,150 @@ static const char *colorGetKey(const char *fileNamePtr, fileInfoTypesEnum type,
 
         if (otherSpecial && otherWrite)
         {
-            return "tw";
+            return &colorTypesList[colorKeyStickyOtherWritable];
         }
 
         if (otherWrite)
         {
-            return "ow";
+            return &colorTypesList[colorKeyOtherWritable];
         }
 
         if (otherSpecial)
         {
-            return "st";
+            return &colorTypesList[colorKeySticky];
         }
 
-        return "di";
+        return &colorTypesList[colorKeyDirectory];
     }
 
     if (accessPtr->owner.bits.special)
     {
-        return "su";
+        return &colorTypesList[colorKeySetUid];
     }
 
     if (accessPtr->group.bits.special)
     {
-        return "sg";
+        return &colorTypesList[colorKeySetGid];
     }
 
-    size_t fileNameLength = strlen(fileNamePtr);
+    uint32_t extensionIndex = colorTrieFind(fileNamePtr, strlen(fileNamePtr));
+    if (extensionIndex != COLOR_TRIE_NONE)
+    {
+        return &colorExtensionsList[extensionIndex].esc;
+    }
 
-    for (size_t i = 0; i < colorListCount; ++i)
+    if (accessPtr->owner.bits.execute ||
+        accessPtr->group.bits.execute ||
+        accessPtr->other.bits.execute)
     {
-        const char *pattern = colorList[i].key;
+        return &colorTypesList[colorKeyExecutable];
+    }
+
+    return &colorTypesList[colorKeyFile];
+}
+
+static void colorTrieInsert(uint32_t extensionIndex, bool *isOkPtr)
+{
+    *isOkPtr = true;
+
+    const colorExtensionStruct *extensionPtr = &colorExtensionsList[extensionIndex];
+
+    // Каждый символ суффикса может добавить не больше одного узла. Плюс корень
+    size_t requiredCount = colorTrieCount + extensionPtr->suffixLength + 1;
 
-        if (strlen(pattern) < 2 || strncmp(pattern, "*.", strlen("*.")) != 0)
+    if (requiredCount > COLOR_TRIE_NONE)
+    {
+        *isOkPtr = false;
+        return;
+    }
+
+    if (requiredCount > colorTrieCapacity)
+    {
+        size_t newCapacity = colorTrieCapacity ? colorTrieCapacity : 256;
+
+        while (newCapacity < requiredCount)
         {
-            continue;
+            newCapacity *= 2;
         }
 
-        const char *suffix       = pattern + 1;
-        size_t      suffixLength = strlen(suffix);
+        colorTrieNodeStruct *newListPtr = realloc(colorTrieList, newCapacity * sizeof(colorTrieNodeStruct));
+        if (!newListPtr)
+        {
+            *isOkPtr = false;
+            return;
+        }
+
+        colorTrieList     = newListPtr;
+        colorTrieCapacity = newCapacity;
+    }
 
-        if (fileNameLength < suffixLength)
+    if (!colorTrieCount)
+    {
+        colorTrieList[0] = (colorTrieNodeStruct){0, 0, COLOR_TRIE_NONE, '\0'};
+        colorTrieCount   = 1;
+    }
+
+    uint32_t node = 0;
+
+    for (size_t i = extensionPtr->suffixLength; i > 0; --i)
+    {
+        char     symbol = extensionPtr->suffixPtr[i - 1];
+        uint32_t child  = colorTrieList[node].childIndex;
+
+        while (child && colorTrieList[child].symbol != symbol)
         {
-            continue;
+            child = colorTrieList[child].siblingIndex;
         }
 
-        if (strcmp(fileNamePtr + fileNameLength - suffixLength, suffix) == 0)
+        if (!child)
         {
-            return colorList[i].key;
+            child = (uint32_t)colorTrieCount++;
+
+            colorTrieList[child] = (colorTrieNodeStruct){0, colorTrieList[node].childIndex, COLOR_TRIE_NONE, symbol};
+            colorTrieList[node].childIndex = child;
         }
+
+        node = child;
     }
 
-    if (accessPtr->owner.bits.execute ||
-        accessPtr->group.bits.execute ||
-        accessPtr->other.bits.execute)
+    // Суффиксы добавляются в порядке LS_COLORS, поэтому первое вхождение имеет меньший индекс
+    if (colorTrieList[node].extensionIndex == COLOR_TRIE_NONE)
     {
-        return "ex";
+        colorTrieList[node].extensionIndex = extensionIndex;
     }
-
-    return "fi";
 }
 
-static const char *colorGetAnsi(const char *key)
+static uint32_t colorTrieFind(const char *fileNamePtr, size_t fileNameLength)
 {
-    const char *answer = 0;
+    uint32_t answer = COLOR_TRIE_NONE;
 
-    if (!key)
+    if (!colorTrieCount)
     {
         return answer;
     }
 
-    for (int i = 0; i < colorListCount; ++i)
+    uint32_t node = 0;
+
+    for (size_t i = fileNameLength; i > 0; --i)
     {
-        if (strcmp(&colorList[i].key[0], key) == 0)
+        uint32_t child = colorTrieList[node].childIndex;
+
+        while (child && colorTrieList[child].symbol != fileNamePtr[i - 1])
+        {
+            child = colorTrieList[child].siblingIndex;
+        }
+
+        if (!child)
         {
-            answer = &colorList[i].ansi[0];
             break;
         }
-    }
 
-    if (!answer)
-    {
-        for (int i = 0; i < colorListDefaultCount; ++i)
+        node = child;
+
+        if (colorTrieList[node].extensionIndex < answer)
         {
-            if (strcmp(&colorListDefault[i].key[0], key) == 0)
-            {
-                answer = &colorListDefault[i].ansi[0];
-                break;
-            }
-        }        
+            answer = colorTrieList[node].extensionIndex;
+        }
     }
 
     return answer;
@@ -0,0 +1,146 @@
+/// @file       dirReader.c
+/// @brief      См. dirReader.h
+/// @author     Тузиков Г.А. janisrus35@gmail.com
+
+#include "dirReader.h"
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+/*
+    Внутренние структуры
+*/
+
+/// @brief      Структура записи директории, возвращаемая getdents64
+typedef struct dirReaderDirent64Struct
+{
+    uint64_t       d_ino;    ///< Номер inode
+    int64_t        d_off;    ///< Смещение следующей записи
+    unsigned short d_reclen; ///< Размер записи
+    unsigned char  d_type;   ///< Тип файла
+    char           d_name[]; ///< Имя файла с \0
+}dirReaderDirent64Struct;
+
+/*
+    Функции
+*/
+
+void dirReaderOpen(dirReaderStruct *readerPtr, const char *dirPtr, size_t bufferSize, bool *isOkPtr)
+{
+    bool isOk = true;
+
+    if (!isOkPtr)
+    {
+        isOkPtr = &isOk;
+    }
+
+    *isOkPtr = true;
+
+    if (!readerPtr || !dirPtr)
+    {
+        *isOkPtr = false;
+        return;
+    }
+
+    memset(readerPtr, 0, sizeof(dirReaderStruct));
+    readerPtr->fd = -1;
+
+    if (!bufferSize)
+    {
+        bufferSize = DIR_READER_BUFFER_SIZE_DEFAULT;
+    }
+    if (bufferSize < DIR_READER_BUFFER_SIZE_MIN)
+    {
+        bufferSize = DIR_READER_BUFFER_SIZE_MIN;
+    }
+
+    readerPtr->fd = open(dirPtr, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (readerPtr->fd < 0)
+    {
+        *isOkPtr = false;
+        return;
+    }
+
+    readerPtr->bufferPtr = malloc(bufferSize);
+    if (!readerPtr->bufferPtr)
+    {
+        close(readerPtr->fd);
+        readerPtr->fd = -1;
+        *isOkPtr = false;
+        return;
+    }
+
+    readerPtr->bufferSize = bufferSize;
+}
+
+bool dirReaderNext(dirReaderStruct *readerPtr, dirReaderEntryStruct *entryPtr, bool *isOkPtr)
+{
+    bool isOk = true;
+
+    if (!isOkPtr)
+    {
+        isOkPtr = &isOk;
+    }
+
+    *isOkPtr = true;
+
+    if (!readerPtr || !entryPtr || readerPtr->fd < 0 || !readerPtr->bufferPtr)
+    {
+        *isOkPtr = false;
+        return false;
+    }
+
+    if (readerPtr->position >= readerPtr->bufferLength)
+    {
+        long answer = 0;
+
+        answer = syscall(SYS_getdents64, readerPtr->fd, readerPtr->bufferPtr, readerPtr->bufferSize);
+        if (answer < 0)
+        {
+            *isOkPtr = false;
+            return false;
+        }
+
+        readerPtr->bufferLength = (size_t)answer;
+        readerPtr->position     = 0;
+
+        if (!answer)
+        {
+            return false;
+        }
+    }
+
+    const dirReaderDirent64Struct *direntPtr = 0;
+
+    direntPtr = (const dirReaderDirent64Struct *)&readerPtr->bufferPtr[readerPtr->position];
+
+    entryPtr->inode      = direntPtr->d_ino;
+    entryPtr->type       = direntPtr->d_type;
+    entryPtr->namePtr    = &direntPtr->d_name[0];
+    entryPtr->nameLength = strlen(&direntPtr->d_name[0]);
+
+    readerPtr->position += direntPtr->d_reclen;
+
+    return true;
+}
+
+void dirReaderClose(dirReaderStruct *readerPtr)
+{
+    // Структура считается открытой только при наличии буфера, поэтому обнуленная структура закрывается безопасно
+    if (!readerPtr || !readerPtr->bufferPtr)
+    {
+        return;
+    }
+
+    close(readerPtr->fd);
+    readerPtr->fd = -1;
+
+    free(readerPtr->bufferPtr);
+    readerPtr->bufferPtr = 0;
+
+    readerPtr->bufferSize   = 0;
+    readerPtr->bufferLength = 0;
+    readerPtr->position     = 0;
+}
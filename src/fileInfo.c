@@ -2,13 +2,16 @@
 /// @brief      См. fileInfo.h
 /// @author     Тузиков Г.А. janisrus35@gmail.com
 
+#define _GNU_SOURCE
+
 #include "fileInfo.h"
+#include "statRing.h"
+#include "idName.h"
 #include <errno.h>
+#include <fcntl.h>
 #include <string.h>
 #include <sys/stat.h>
 #include <sys/types.h>
-#include <pwd.h>
-#include <grp.h>
 #include <unistd.h>
 #include <stdio.h>
 #include <libgen.h>
@@ -16,22 +19,204 @@
 #include <math.h>
 #include <inttypes.h>
 #include <sys/sysmacros.h>
+#include <pthread.h>
+
+/*
+    Внутренние структуры
+*/
+
+/// @brief      Структура записи кеша дат
+/// @details    Хранит начало строки с датой, общее для всех моментов времени одних локальных суток
+typedef struct fileInfoTimeCacheEntryStruct
+{
+    time_t start;                                     ///< Начало суток (включительно)
+    time_t end;                                       ///< Конец суток (не включительно)
+    char   prefix[FILE_INFO_TIME_PREFIX_MAX_LENGTH];  ///< Месяц и день, например "Oct 17 "
+    size_t prefixLength;                              ///< Длина prefix без \0
+    char   year[5];                                   ///< Год
+}fileInfoTimeCacheEntryStruct;
+
+/*
+    Прототипы внутренних функций
+*/
+
+/// @brief      Функция получения информации о файле без следования по ссылке
+/// @details    Данная функция выполняет вызов statx, запрашивая только поля, соответствующие fields.
+///                 Результат преобразуется в struct stat.
+///                 Если statx недоступен, выполняется вызов fstatat
+/// @param[in]  dirFd   Дескриптор директории, относительно которой задан filePtr, или AT_FDCWD
+/// @param[in]  filePtr Указатель на путь к файлу
+/// @param[in]  fields  Битовая маска необходимых полей из fileInfoFieldsEnum
+/// @param[out] statPtr Указатель на результат
+/// @return     Возвращает 0 в случае успешного выполнения функции.
+///                 В противном случае, возвращает -1 и устанавливает errno
+static int fileInfoStatFields(int dirFd, const char *filePtr, uint32_t fields, struct stat *statPtr);
+
+/// @brief      Функция установки текущего файла контекста с указанием необходимых полей
+/// @details    Аналог fileInfoContextSetFileAt(), запрашивающий только поля fields
+/// @param[in]  contextPtr Указатель на контекст
+/// @param[in]  dirFd      Дескриптор директории, относительно которой задан filePtr, или AT_FDCWD
+/// @param[in]  filePtr    Указатель на путь к файлу
+/// @param[in]  fields     Битовая маска необходимых полей из fileInfoFieldsEnum
+/// @return     Возвращает true если задать текущий файл как filePtr удалось.
+///                 В противном случае, возвращает false
+static bool fileInfoContextSetFileFields(fileInfoContextStruct *contextPtr, int dirFd, const char *filePtr, uint32_t fields);
+
+/// @brief      Функция установки текущего файла контекста по уже полученному результату stat
+/// @param[in]  contextPtr Указатель на контекст
+/// @param[in]  dirFd      Дескриптор директории, относительно которой задан filePtr, или AT_FDCWD
+/// @param[in]  filePtr    Указатель на путь к файлу
+/// @param[in]  statPtr    Указатель на результат stat файла
+/// @return     Возвращает true если задать текущий файл как filePtr удалось.
+///                 В противном случае, возвращает false
+static bool fileInfoContextSetFileStat(fileInfoContextStruct *contextPtr, int dirFd, const char *filePtr, const struct stat *statPtr);
+
+/// @brief      Функция получения всей информации о файле по уже полученному результату stat
+/// @details    Аналог fileInfoGetContextAt(). Если statPtr не равен 0, stat самого файла не выполняется
+/// @param[in]  contextPtr   Указатель на контекст
+/// @param[in]  dirFd        Дескриптор директории или AT_FDCWD
+/// @param[in]  filePtr      Указатель на путь к файлу
+/// @param[in]  statPtr      Указатель на результат stat файла. Может быть равен 0
+/// @param[out] fileInfoPtr  Указатель на информацию о файле
+/// @param[in]  isFollowLink Флаг следования по ссылке до конца
+/// @param[out] isOkPtr      Указатель на флаг успешного выполнения операции
+static void fileInfoGetStatAt(fileInfoContextStruct *contextPtr, int dirFd, const char *filePtr, const struct stat *statPtr, fileInfoStruct *fileInfoPtr, bool isFollowLink, bool *isOkPtr);
+
+/// @brief      Функция получения количества десятичных цифр числа
+/// @param[in]  value Число
+/// @return     Возвращает количество цифр value
+static size_t fileInfoDigitsCount(uint64_t value);
+
+/// @brief      Функция записи десятичного представления числа
+/// @details    Данная функция выполняет запись value в stringPtr без \0, по две цифры за шаг
+/// @param[in]  value     Число
+/// @param[out] stringPtr Указатель на строку
+/// @warning    Длина stringPtr должна быть не меньше fileInfoDigitsCount(value)
+/// @return     Возвращает количество записанных цифр
+static size_t fileInfoUint64ToString(uint64_t value, char *stringPtr);
+
+/// @brief      Функция инициализации данных для вывода времени
+/// @details    Данная функция выполняет получение текущего времени и сокращенных названий месяцев
+///                 текущей локали. Вызывается один раз за время работы программы
+static void fileInfoTimeInit(void);
+
+/// @brief      Функция получения записи кеша дат
+/// @details    Данная функция выполняет поиск суток, содержащих timeEdit, в кеше.
+///                 Если суток в кеше нет, запись вычисляется и добавляется в кеш
+/// @param[in]  timeEdit Время
+/// @return     Возвращает указатель на запись кеша.
+///                 Если сутки содержат переход часового пояса или год не из 4 цифр, возвращает 0
+static const fileInfoTimeCacheEntryStruct *fileInfoTimeCacheGet(time_t timeEdit);
+
+#ifdef STATX_BASIC_STATS
+/// @brief      Функция получения маски statx, соответствующей полям fields
+/// @param[in]  fields Битовая маска необходимых полей из fileInfoFieldsEnum
+/// @return     Возвращает маску statx
+static unsigned int fileInfoFieldsToStatxMask(uint32_t fields);
+
+/// @brief      Функция получения флагов statx
+/// @return     Возвращает флаги statx с учетом fileInfoIsDontSyncEnabled
+static int fileInfoGetStatxFlags(void);
+
+/// @brief      Функция преобразования результата statx в struct stat
+/// @param[in]  statxPtr Указатель на результат statx
+/// @param[out] statPtr  Указатель на результат
+static void fileInfoStatxToStat(const struct statx *statxPtr, struct stat *statPtr);
+#endif
+
+/*
+    Внутренние макроподстановки
+*/
+
+// Значение fileInfoAccessUnion: бит 3 - чтение, бит 2 - запись, бит 1 - исполнение, бит 0 - специальный
+#define FILE_INFO_ACCESS_READ(VALUE)                  (((VALUE) & 8) ? 'r' : '-')
+#define FILE_INFO_ACCESS_WRITE(VALUE)                 (((VALUE) & 4) ? 'w' : '-')
+#define FILE_INFO_ACCESS_EXECUTE(VALUE, SET, UNSET)   (((VALUE) & 1) ? (((VALUE) & 2) ? (SET) : (UNSET)) : \
+                                                                       (((VALUE) & 2) ? 'x'   : '-'))
+
+// Индекс: (owner.value << 8) | (group.value << 4) | other.value
+#define FILE_INFO_ACCESS_ENTRY(I)   {FILE_INFO_ACCESS_READ((I) >> 8),  FILE_INFO_ACCESS_WRITE((I) >> 8),  FILE_INFO_ACCESS_EXECUTE((I) >> 8,  's', 'S'), \
+                                     FILE_INFO_ACCESS_READ((I) >> 4),  FILE_INFO_ACCESS_WRITE((I) >> 4),  FILE_INFO_ACCESS_EXECUTE((I) >> 4,  's', 'S'), \
+                                     FILE_INFO_ACCESS_READ(I),         FILE_INFO_ACCESS_WRITE(I),         FILE_INFO_ACCESS_EXECUTE(I,         't', 'T')},
+#define FILE_INFO_ACCESS_ENTRY4(I)    FILE_INFO_ACCESS_ENTRY(I)      FILE_INFO_ACCESS_ENTRY((I) + 1)      FILE_INFO_ACCESS_ENTRY((I) + 2)      FILE_INFO_ACCESS_ENTRY((I) + 3)
+#define FILE_INFO_ACCESS_ENTRY16(I)   FILE_INFO_ACCESS_ENTRY4(I)     FILE_INFO_ACCESS_ENTRY4((I) + 4)     FILE_INFO_ACCESS_ENTRY4((I) + 8)     FILE_INFO_ACCESS_ENTRY4((I) + 12)
+#define FILE_INFO_ACCESS_ENTRY64(I)   FILE_INFO_ACCESS_ENTRY16(I)    FILE_INFO_ACCESS_ENTRY16((I) + 16)   FILE_INFO_ACCESS_ENTRY16((I) + 32)   FILE_INFO_ACCESS_ENTRY16((I) + 48)
+#define FILE_INFO_ACCESS_ENTRY256(I)  FILE_INFO_ACCESS_ENTRY64(I)    FILE_INFO_ACCESS_ENTRY64((I) + 64)   FILE_INFO_ACCESS_ENTRY64((I) + 128)  FILE_INFO_ACCESS_ENTRY64((I) + 192)
+#define FILE_INFO_ACCESS_ENTRY1024(I) FILE_INFO_ACCESS_ENTRY256(I)   FILE_INFO_ACCESS_ENTRY256((I) + 256) FILE_INFO_ACCESS_ENTRY256((I) + 512) FILE_INFO_ACCESS_ENTRY256((I) + 768)
+
+/*
+    Внутренние переменные
+*/
+
+/// @brief      Таблица строковых представлений прав доступа
+/// @details    Строится препроцессором при сборке. Индекс описан у FILE_INFO_ACCESS_ENTRY
+static const char fileInfoAccessStringsList[4096][9] =
+{
+    FILE_INFO_ACCESS_ENTRY1024(0)
+    FILE_INFO_ACCESS_ENTRY1024(1024)
+    FILE_INFO_ACCESS_ENTRY1024(2048)
+    FILE_INFO_ACCESS_ENTRY1024(3072)
+};
+
+/// @brief      Таблица пар десятичных цифр от 00 до 99
+static const char fileInfoDigitsPairsList[200] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/// @brief      Таблица степеней 10
+static const uint64_t fileInfoPowersOf10List[20] =
+{
+    1ULL,                10ULL,                100ULL,                1000ULL,
+    10000ULL,            100000ULL,            1000000ULL,            10000000ULL,
+    100000000ULL,        1000000000ULL,        10000000000ULL,        100000000000ULL,
+    1000000000000ULL,    10000000000000ULL,    100000000000000ULL,    1000000000000000ULL,
+    10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL
+};
+
+/// @brief      Флаг однократной инициализации данных для вывода времени
+pthread_once_t fileInfoTimeOnce = PTHREAD_ONCE_INIT;
+
+/// @brief      Текущее время, полученное один раз за время работы программы
+time_t fileInfoCurrentTime = 0;
+
+/// @brief      Сокращенные названия месяцев текущей локали
+char fileInfoMonthsList[12][FILE_INFO_MONTH_MAX_LENGTH] = {0};
+
+/// @brief      Длины fileInfoMonthsList
+size_t fileInfoMonthsLengthList[12] = {0};
+
+/// @brief      Флаг доступности fileInfoMonthsList
+bool fileInfoIsMonthsListReady = false;
+
+/// @brief      Кеш дат. У каждого потока свой
+_Thread_local fileInfoTimeCacheEntryStruct fileInfoTimeCache[FILE_INFO_TIME_CACHE_SIZE] = {0};
 
 /*
-    Константы
+    Переменные
 */
 
-/// @brief      Путь до активного файла
-char *fileInfoPath = 0;
+uint32_t fileInfoFields = fileInfoFieldAll;
 
-/// @brief      Результат вызова lstat активного файла
-struct stat fileInfoStat = {0};
+bool fileInfoIsDontSyncEnabled = false;
 
 /*
     Функции
 */
 
 bool fileInfoIsExists(const char *filePtr, bool *isOkPtr)
+{
+    return fileInfoIsExistsAt(AT_FDCWD, filePtr, isOkPtr);
+}
+
+bool fileInfoIsExistsAt(int dirFd, const char *filePtr, bool *isOkPtr)
 {
     bool isOk = true;
 
@@ -50,7 +235,7 @@ bool fileInfoIsExists(const char *filePtr, bool *isOkPtr)
         return false;
     }
 
-    if (lstat(filePtr, &fileInfo) && errno == ENOENT)
+    if (fileInfoStatFields(dirFd, filePtr, fileInfoFieldType, &fileInfo) && errno == ENOENT)
     {
         return false;
     }
@@ -59,6 +244,11 @@ bool fileInfoIsExists(const char *filePtr, bool *isOkPtr)
 }
 
 void fileInfoGet(const char *filePtr, fileInfoStruct *fileInfoPtr, bool isFollowLink, bool *isOkPtr)
+{
+    fileInfoGetAt(AT_FDCWD, filePtr, fileInfoPtr, isFollowLink, isOkPtr);
+}
+
+void fileInfoGetAt(int dirFd, const char *filePtr, fileInfoStruct *fileInfoPtr, bool isFollowLink, bool *isOkPtr)
 {
     bool isOk = true;
 
@@ -67,298 +257,258 @@ void fileInfoGet(const char *filePtr, fileInfoStruct *fileInfoPtr, bool isFollow
         isOkPtr = &isOk;
     }
 
-    *isOkPtr = true;
+    fileInfoContextStruct context = {0};
 
-    // Объявление переменных, используемых в cleanup
-    char *filePtrCopy1    = 0;
-    char *filePtrCopy2    = 0;
-    char *linkTargetPtr   = 0;
+    fileInfoGetContextAt(&context, dirFd, filePtr, fileInfoPtr, isFollowLink, isOkPtr);
 
-    if (!filePtr || !fileInfoPtr || !fileInfoSetActiveFile(filePtr))
-    {
-        *isOkPtr = false;
-        goto cleanup;
-    }
-    
-    memset(fileInfoPtr, 0, sizeof(fileInfoStruct));
+    fileInfoContextClear(&context);
+}
 
-    filePtrCopy1 = strdup(filePtr);
-    if (!filePtrCopy1) 
+void fileInfoGetContextAt(fileInfoContextStruct *contextPtr, int dirFd, const char *filePtr, fileInfoStruct *fileInfoPtr, bool isFollowLink, bool *isOkPtr)
+{
+    bool isOk = true;
+
+    if (!isOkPtr)
     {
-        *isOkPtr = false;
-        goto cleanup;
+        isOkPtr = &isOk;
     }
 
-    filePtrCopy2 = strdup(filePtr);
-    if (!filePtrCopy2) 
+    if (!contextPtr)
     {
         *isOkPtr = false;
-        goto cleanup;
+        return;
     }
 
-    char *fileNamePtr = 0;
-    char *filePathPtr = 0;
+    fileInfoGetStatAt(contextPtr, dirFd, filePtr, 0, fileInfoPtr, isFollowLink, isOkPtr);
+}
 
-    fileNamePtr = basename(filePtrCopy1);
-    filePathPtr = dirname(filePtrCopy2);
+void fileInfoGetBatchAt(int dirFd, const char *const *filesList, fileInfoStruct *const *fileInfoList, size_t count, bool isFollowLink, bool *isOkPtr)
+{
+    bool isOk = true;
 
-    fileInfoPtr->fileNamePtr = strdup(fileNamePtr);
-    if (!fileInfoPtr->fileNamePtr)
+    if (!isOkPtr)
     {
-        *isOkPtr = false;
-        goto cleanup;
+        isOkPtr = &isOk;
     }
 
-    fileInfoPtr->type = fileInfoGetType(isOkPtr);
-    if (!*isOkPtr)
-    {
-        goto cleanup;
-    }
+    *isOkPtr = true;
 
-    fileInfoPtr->access = fileInfoGetAccess(isOkPtr);
-    if (!*isOkPtr)
+    if (!filesList || !fileInfoList)
     {
-        goto cleanup;
+        *isOkPtr = false;
+        return;
     }
 
-    fileInfoPtr->linksCount = fileInfoGetLinksCount(isOkPtr);
-    if (!*isOkPtr)
+#ifdef STATX_BASIC_STATS
+    /// @brief      Структура ячейки запроса, находящегося в ядре
+    typedef struct fileInfoBatchSlotStruct
     {
-        goto cleanup;
-    }
+        struct statx result;     ///< Результат statx
+        size_t       index;      ///< Индекс файла в filesList
+        bool         isInFlight; ///< Флаг запроса, результат которого еще не получен
+    }fileInfoBatchSlotStruct;
 
-    fileInfoPtr->ownerId = fileInfoGetOwnerId(isOkPtr);
-    if (!*isOkPtr)
-    {
-        goto cleanup;
-    }
+    // Объявление переменных, используемых в cleanup
+    fileInfoContextStruct    context        = {0};
+    statRingStruct           ring           = {0};
+    fileInfoBatchSlotStruct *slotsList      = 0;
+    unsigned int            *freeSlotsList  = 0;
+    size_t                   inFlightCount  = 0;
+    size_t                   next           = 0;
+    bool                     isRingOk       = false;
 
-    fileInfoPtr->groupId = fileInfoGetGroupId(isOkPtr);
-    if (!*isOkPtr)
-    {
-        goto cleanup;
-    }
-    
-    fileInfoPtr->size = fileInfoGetSize(isOkPtr);
-    if (!*isOkPtr)
-    {
-        goto cleanup;
-    }
-    
-    fileInfoPtr->deviceNumber = fileInfoGetDeviceNumber(isOkPtr);
-    if (!*isOkPtr)
+    statRingOpen(&ring, FILE_INFO_BATCH_DEPTH, &isRingOk);
+    if (!isRingOk)
     {
         goto cleanup;
     }
 
-    fileInfoPtr->timeEdit = fileInfoGetTimeEdit(isOkPtr);
-    if (!*isOkPtr)
+    slotsList     = malloc(ring.depth * sizeof(fileInfoBatchSlotStruct));
+    freeSlotsList = malloc(ring.depth * sizeof(unsigned int));
+    if (!slotsList || !freeSlotsList)
     {
+        isRingOk = false;
         goto cleanup;
     }
-    
-    fileInfoPtr->blocks = fileInfoGet512BytesBlocks(isOkPtr);
-    if (!*isOkPtr)
+
+    unsigned int freeSlotsCount = ring.depth;
+    unsigned int mask           = fileInfoFieldsToStatxMask(fileInfoFields);
+    int          flags          = fileInfoGetStatxFlags();
+
+    for (unsigned int i = 0; i < ring.depth; ++i)
     {
-        goto cleanup;
+        freeSlotsList[i]        = i;
+        slotsList[i].isInFlight = false;
     }
 
-    if (fileInfoPtr->type == fileInfoTypeLink)
+    // После ошибки новые запросы не отправляются, но результаты уже отправленных
+    // необходимо дождаться: ядро пишет их в slotsList
+    while ((isRingOk && *isOkPtr && next < count) || inFlightCount)
     {
-        linkTargetPtr = malloc(FILE_INFO_TARGET_LENGTH_MAX);
-        if (!linkTargetPtr)
-        {
-            *isOkPtr = false;
-            goto cleanup;
-        }
-
-        fileInfoGetLinkTarget(linkTargetPtr, FILE_INFO_TARGET_LENGTH_MAX, isOkPtr);
-        if (!*isOkPtr)
+        while (isRingOk && *isOkPtr && next < count && freeSlotsCount)
         {
-            goto cleanup;
-        }
+            unsigned int slot = freeSlotsList[freeSlotsCount - 1];
 
-        if (linkTargetPtr[0] == '/')
-        {
-            fileInfoPtr->targetInfo.filePathPtr = strdup(linkTargetPtr);
-            if (!fileInfoPtr->targetInfo.filePathPtr)
+            slotsList[slot].index = next;
+            if (!statRingPrepareStatx(&ring, dirFd, filesList[next], flags, mask, &slotsList[slot].result, slot))
             {
-                *isOkPtr = false;
-                goto cleanup;
+                break;
             }
-        }
-        else
-        {
-            size_t filePathLength = 0;
 
-            // \0 и /
-            filePathLength = strlen(filePathPtr) + strlen(linkTargetPtr) + 2;
-    
-            fileInfoPtr->targetInfo.filePathPtr = malloc(filePathLength);
-            if (!fileInfoPtr->targetInfo.filePathPtr)
-            {
-                *isOkPtr = false;
-                goto cleanup;
-            }
-            if (snprintf(fileInfoPtr->targetInfo.filePathPtr,
-                         filePathLength,
-                         "%s/%s", 
-                         filePathPtr, 
-                         linkTargetPtr) < 0)
-            {
-                *isOkPtr = false;
-                goto cleanup;
-            }
-        }
-        fileInfoPtr->targetInfo.fileNamePtr = &fileInfoPtr->targetInfo.filePathPtr[strlen(fileInfoPtr->targetInfo.filePathPtr) - strlen(linkTargetPtr)];
+            slotsList[slot].isInFlight = true;
 
-        fileInfoPtr->targetInfo.isTargetExists = fileInfoIsExists(fileInfoPtr->targetInfo.filePathPtr, isOkPtr);
-        if (!*isOkPtr)
-        {
-            goto cleanup;
+            --freeSlotsCount;
+            ++inFlightCount;
+            ++next;
         }
 
-        if (fileInfoPtr->targetInfo.isTargetExists)
+        bool isSubmitOk = true;
+
+        statRingSubmit(&ring, 1, &isSubmitOk);
+        if (!isSubmitOk)
         {
-            if (!fileInfoSetActiveFile(fileInfoPtr->targetInfo.filePathPtr))
+            // Ошибка кольца во время работы не является ошибкой получения информации:
+            //     новые запросы не ставятся, поставленные дожидаются повторной отправкой,
+            //     а файлы без результата обрабатываются последовательно.
+            //     Повторная ошибка прекращает ожидание
+            if (!isRingOk)
             {
-                *isOkPtr = false;
-                goto cleanup;
+                break;
             }
 
-            fileInfoPtr->targetInfo.access = fileInfoGetAccess(isOkPtr);
-            if (!*isOkPtr)
-            {
-                goto cleanup;
-            }
+            isRingOk = false;
+            continue;
+        }
 
-            fileInfoPtr->targetInfo.type = fileInfoGetType(isOkPtr);
-            if (!*isOkPtr)
-            {
-                goto cleanup;
-            }
+        uint64_t userData = 0;
+        int32_t  result   = 0;
 
-            char *filePathOrig = 0;
-            char *fileNameOrig = 0;
-            
-            filePathOrig = fileInfoPtr->targetInfo.filePathPtr;
-            fileNameOrig = fileInfoPtr->targetInfo.fileNamePtr;
+        while (statRingReap(&ring, &userData, &result))
+        {
+            fileInfoBatchSlotStruct *slotPtr = &slotsList[userData];
 
-            char *fileNameBufferPtr = 0;
-            char *linkPathBufferPtr = 0;
+            slotPtr->isInFlight = false;
+            --inFlightCount;
 
-            while (fileInfoPtr->targetInfo.type == fileInfoTypeLink && isFollowLink)
+            if (*isOkPtr)
             {
-                fileInfoStruct linkInfo = {0};
-
-                fileInfoGet(fileInfoPtr->targetInfo.filePathPtr, &linkInfo, false, isOkPtr);
-                if (!*isOkPtr)
+                if (!result)
                 {
-                    break;
-                }
-                fileInfoPtr->targetInfo = linkInfo.targetInfo;
+                    struct stat fileInfo = {0};
 
-                if (fileNameBufferPtr)
-                {
-                    free(fileNameBufferPtr);
+                    fileInfoStatxToStat(&slotPtr->result, &fileInfo);
+                    fileInfoGetStatAt(&context, dirFd, filesList[slotPtr->index], &fileInfo, fileInfoList[slotPtr->index], isFollowLink, isOkPtr);
                 }
-                fileNameBufferPtr = linkInfo.fileNamePtr;
-
-                if (linkPathBufferPtr)
+                else
                 {
-                    free(linkPathBufferPtr);
+                    // Ошибка обрабатывается так же, как при последовательном получении информации
+                    fileInfoGetContextAt(&context, dirFd, filesList[slotPtr->index], fileInfoList[slotPtr->index], isFollowLink, isOkPtr);
                 }
-                linkPathBufferPtr = linkInfo.targetInfo.filePathPtr;
             }
 
-            if (fileNameBufferPtr)
-            {
-                free(fileNameBufferPtr);
-                fileNameBufferPtr = 0;
-            }
-            if (linkPathBufferPtr)
+            freeSlotsList[freeSlotsCount++] = (unsigned int)userData;
+        }
+    }
+
+cleanup:
+
+    if (slotsList && inFlightCount)
+    {
+        // Файлы, результаты запросов которых не получены, обрабатываются последовательно
+        for (unsigned int i = 0; i < ring.depth && *isOkPtr; ++i)
+        {
+            if (slotsList[i].isInFlight)
             {
-                free(linkPathBufferPtr);
-                linkPathBufferPtr = 0;
+                fileInfoGetContextAt(&context, dirFd, filesList[slotsList[i].index], fileInfoList[slotsList[i].index], isFollowLink, isOkPtr);
             }
-
-            fileInfoPtr->targetInfo.filePathPtr = filePathOrig;
-            fileInfoPtr->targetInfo.fileNamePtr = fileNameOrig;
         }
+
+        // Невыполненные запросы могут быть выполнены позже, поэтому slotsList не освобождается
+        slotsList = 0;
     }
 
-cleanup:
+    if (slotsList)
+    {
+        free(slotsList);
+        slotsList = 0;
+    }
 
-    if (filePtrCopy1)
+    if (freeSlotsList)
     {
-        free(filePtrCopy1);
-        filePtrCopy1 = 0;
+        free(freeSlotsList);
+        freeSlotsList = 0;
     }
 
-    if (filePtrCopy2)
+    if (!inFlightCount)
     {
-        free(filePtrCopy2);
-        filePtrCopy2 = 0;
+        statRingClose(&ring);
     }
 
-    if (linkTargetPtr)
+    if (isRingOk || !*isOkPtr)
     {
-        free(linkTargetPtr);
-        linkTargetPtr = 0;
+        fileInfoContextClear(&context);
+        return;
     }
+#else
+    fileInfoContextStruct context = {0};
+    size_t                next    = 0;
+#endif
 
-    if (!*isOkPtr)
+    // Файлы, запросы о которых не отправлялись в кольцо
+    for (size_t i = next; i < count && *isOkPtr; ++i)
     {
-        if (fileInfoPtr->fileNamePtr)
-        {
-            free(fileInfoPtr->fileNamePtr);
-            fileInfoPtr->fileNamePtr = 0;
-        }
-        if (fileInfoPtr->targetInfo.filePathPtr)
-        {
-            free(fileInfoPtr->targetInfo.filePathPtr);
-            fileInfoPtr->targetInfo.filePathPtr = 0;
-        }
+        fileInfoGetContextAt(&context, dirFd, filesList[i], fileInfoList[i], isFollowLink, isOkPtr);
     }
+
+    fileInfoContextClear(&context);
 }
 
-bool fileInfoSetActiveFile(const char *filePtr)
+void fileInfoClear(fileInfoStruct *fileInfoPtr)
 {
-    struct stat fileInfo = {0};
-
-    if (!filePtr || lstat(filePtr, &fileInfo))
+    if (!fileInfoPtr)
     {
-        return false;
+        return;
     }
 
-    if (fileInfoPath)
+    if (fileInfoPtr->fileNamePtr)
     {
-        free(fileInfoPath);
-        fileInfoPath = 0;
+        free(fileInfoPtr->fileNamePtr);
+        fileInfoPtr->fileNamePtr = 0;
     }
-    
-    fileInfoPath = malloc(strlen(filePtr) + 1);
-    if (!fileInfoPath)
+    if (fileInfoPtr->targetInfo.filePathPtr)
     {
-        return false;
+        free(fileInfoPtr->targetInfo.filePathPtr);
+        fileInfoPtr->targetInfo.filePathPtr = 0;
     }
-    strcpy(fileInfoPath, filePtr);
+}
 
-    fileInfoStat = fileInfo;
+bool fileInfoContextSetFile(fileInfoContextStruct *contextPtr, const char *filePtr)
+{
+    return fileInfoContextSetFileAt(contextPtr, AT_FDCWD, filePtr);
+}
 
-    return true;
+bool fileInfoContextSetFileAt(fileInfoContextStruct *contextPtr, int dirFd, const char *filePtr)
+{
+    return fileInfoContextSetFileFields(contextPtr, dirFd, filePtr, fileInfoFields);
 }
 
-void fileInfoClearActiveFile(void)
+void fileInfoContextClear(fileInfoContextStruct *contextPtr)
 {
-    if (fileInfoPath)
+    if (!contextPtr)
     {
-        free(fileInfoPath);
-        fileInfoPath = 0;
+        return;
     }
+
+    if (contextPtr->filePathPtr)
+    {
+        free(contextPtr->filePathPtr);
+        contextPtr->filePathPtr = 0;
+    }
+
+    memset(contextPtr, 0, sizeof(fileInfoContextStruct));
 }
 
-fileInfoTypesEnum fileInfoGetType(bool *isOkPtr)
+fileInfoTypesEnum fileInfoGetType(const fileInfoContextStruct *contextPtr, bool *isOkPtr)
 {
     bool isOk = true;
 
@@ -369,37 +519,37 @@ fileInfoTypesEnum fileInfoGetType(bool *isOkPtr)
 
     *isOkPtr = true;
 
-    if (!fileInfoPath)
+    if (!contextPtr || !contextPtr->isFileSet)
     {
         *isOkPtr = false;
         return fileInfoTypeUnknown;
     }
 
-    if (S_ISDIR(fileInfoStat.st_mode))
+    if (S_ISDIR(contextPtr->stat.st_mode))
     {
         return fileInfoTypeDirectory;
     }
-    if (S_ISCHR(fileInfoStat.st_mode))
+    if (S_ISCHR(contextPtr->stat.st_mode))
     {
         return fileInfoTypeChar;
     }
-    if (S_ISBLK(fileInfoStat.st_mode))
+    if (S_ISBLK(contextPtr->stat.st_mode))
     {
         return fileInfoTypeBlock;
     }
-    if (S_ISREG(fileInfoStat.st_mode))
+    if (S_ISREG(contextPtr->stat.st_mode))
     {
         return fileInfoTypeFile;
     }
-    if (S_ISFIFO(fileInfoStat.st_mode))
+    if (S_ISFIFO(contextPtr->stat.st_mode))
     {
         return fileInfoTypeFIFO;
     }
-    if (S_ISLNK(fileInfoStat.st_mode))
+    if (S_ISLNK(contextPtr->stat.st_mode))
     {
         return fileInfoTypeLink;
     }
-    if (S_ISSOCK(fileInfoStat.st_mode))
+    if (S_ISSOCK(contextPtr->stat.st_mode))
     {
         return fileInfoTypeSock;
     }
@@ -408,7 +558,7 @@ fileInfoTypesEnum fileInfoGetType(bool *isOkPtr)
     return fileInfoTypeUnknown;
 }
 
-fileInfoAccessStruct fileInfoGetAccess(bool *isOkPtr)
+fileInfoAccessStruct fileInfoGetAccess(const fileInfoContextStruct *contextPtr, bool *isOkPtr)
 {
     bool isOk = true;
     
@@ -421,31 +571,31 @@ fileInfoAccessStruct fileInfoGetAccess(bool *isOkPtr)
 
     fileInfoAccessStruct answer = {0};
     
-    if (!fileInfoPath)
+    if (!contextPtr || !contextPtr->isFileSet)
     {
         *isOkPtr = false;
         return answer;
     }
 
-    answer.owner.value = ((bool)(fileInfoStat.st_mode & S_IRUSR) << 3) +
-                         ((bool)(fileInfoStat.st_mode & S_IWUSR) << 2) +
-                         ((bool)(fileInfoStat.st_mode & S_IXUSR) << 1) +
-                         ((bool)(fileInfoStat.st_mode & S_ISUID) << 0);
+    answer.owner.value = ((bool)(contextPtr->stat.st_mode & S_IRUSR) << 3) +
+                         ((bool)(contextPtr->stat.st_mode & S_IWUSR) << 2) +
+                         ((bool)(contextPtr->stat.st_mode & S_IXUSR) << 1) +
+                         ((bool)(contextPtr->stat.st_mode & S_ISUID) << 0);
 
-    answer.group.value = ((bool)(fileInfoStat.st_mode & S_IRGRP) << 3) +
-                         ((bool)(fileInfoStat.st_mode & S_IWGRP) << 2) +
-                         ((bool)(fileInfoStat.st_mode & S_IXGRP) << 1) +
-                         ((bool)(fileInfoStat.st_mode & S_ISGID) << 0);
+    answer.group.value = ((bool)(contextPtr->stat.st_mode & S_IRGRP) << 3) +
+                         ((bool)(contextPtr->stat.st_mode & S_IWGRP) << 2) +
+                         ((bool)(contextPtr->stat.st_mode & S_IXGRP) << 1) +
+                         ((bool)(contextPtr->stat.st_mode & S_ISGID) << 0);
 
-    answer.other.value = ((bool)(fileInfoStat.st_mode & S_IROTH) << 3) +
-                         ((bool)(fileInfoStat.st_mode & S_IWOTH) << 2) +
-                         ((bool)(fileInfoStat.st_mode & S_IXOTH) << 1) +
-                         ((bool)(fileInfoStat.st_mode & S_ISVTX) << 0);
+    answer.other.value = ((bool)(contextPtr->stat.st_mode & S_IROTH) << 3) +
+                         ((bool)(contextPtr->stat.st_mode & S_IWOTH) << 2) +
+                         ((bool)(contextPtr->stat.st_mode & S_IXOTH) << 1) +
+                         ((bool)(contextPtr->stat.st_mode & S_ISVTX) << 0);
 
     return answer;
 }
 
-uint32_t fileInfoGetLinksCount(bool *isOkPtr)
+uint32_t fileInfoGetLinksCount(const fileInfoContextStruct *contextPtr, bool *isOkPtr)
 {
     bool isOk = true;
 
@@ -456,17 +606,37 @@ uint32_t fileInfoGetLinksCount(bool *isOkPtr)
 
     *isOkPtr = true;
 
-    if (!fileInfoPath)
+    if (!contextPtr || !contextPtr->isFileSet)
     {
         *isOkPtr = false;
         return 0;
     }
 
-    return fileInfoStat.st_nlink;
+    return contextPtr->stat.st_nlink;
 }
 
 
-uint32_t fileInfoGetOwnerId(bool *isOkPtr)
+uint32_t fileInfoGetOwnerId(const fileInfoContextStruct *contextPtr, bool *isOkPtr)
+{
+    bool isOk = true;
+
+    if (!isOkPtr)
+    {
+        isOkPtr = &isOk;
+    }
+
+    *isOkPtr = true;
+
+    if (!contextPtr || !contextPtr->isFileSet)
+    {
+        *isOkPtr = false;
+        return 0;
+    }
+
+    return contextPtr->stat.st_uid;
+}
+
+uint32_t fileInfoGetGroupId(const fileInfoContextStruct *contextPtr, bool *isOkPtr)
 {
     bool isOk = true;
 
@@ -477,16 +647,16 @@ uint32_t fileInfoGetOwnerId(bool *isOkPtr)
 
     *isOkPtr = true;
 
-    if (!fileInfoPath)
+    if (!contextPtr || !contextPtr->isFileSet)
     {
         *isOkPtr = false;
         return 0;
     }
 
-    return fileInfoStat.st_uid;
+    return contextPtr->stat.st_gid;
 }
 
-uint32_t fileInfoGetGroupId(bool *isOkPtr)
+off_t fileInfoGetSize(const fileInfoContextStruct *contextPtr, bool *isOkPtr)
 {
     bool isOk = true;
 
@@ -497,16 +667,16 @@ uint32_t fileInfoGetGroupId(bool *isOkPtr)
 
     *isOkPtr = true;
 
-    if (!fileInfoPath)
+    if (!contextPtr || !contextPtr->isFileSet)
     {
         *isOkPtr = false;
         return 0;
     }
 
-    return fileInfoStat.st_gid;
+    return contextPtr->stat.st_size;
 }
 
-uint32_t fileInfoGetSize(bool *isOkPtr)
+__uint64_t fileInfoGetDeviceNumber(const fileInfoContextStruct *contextPtr, bool *isOkPtr)
 {
     bool isOk = true;
 
@@ -517,16 +687,16 @@ uint32_t fileInfoGetSize(bool *isOkPtr)
 
     *isOkPtr = true;
 
-    if (!fileInfoPath)
+    if (!contextPtr || !contextPtr->isFileSet)
     {
         *isOkPtr = false;
         return 0;
     }
 
-    return fileInfoStat.st_size;
+    return contextPtr->stat.st_rdev;
 }
 
-__uint64_t fileInfoGetDeviceNumber(bool *isOkPtr)
+time_t fileInfoGetTimeEdit(const fileInfoContextStruct *contextPtr, bool *isOkPtr)
 {
     bool isOk = true;
 
@@ -537,16 +707,16 @@ __uint64_t fileInfoGetDeviceNumber(bool *isOkPtr)
 
     *isOkPtr = true;
 
-    if (!fileInfoPath)
+    if (!contextPtr || !contextPtr->isFileSet)
     {
         *isOkPtr = false;
         return 0;
     }
 
-    return fileInfoStat.st_rdev;
+    return contextPtr->stat.st_mtime;
 }
 
-time_t fileInfoGetTimeEdit(bool *isOkPtr)
+long fileInfoGetTimeEditNsec(const fileInfoContextStruct *contextPtr, bool *isOkPtr)
 {
     bool isOk = true;
 
@@ -557,16 +727,16 @@ time_t fileInfoGetTimeEdit(bool *isOkPtr)
 
     *isOkPtr = true;
 
-    if (!fileInfoPath)
+    if (!contextPtr || !contextPtr->isFileSet)
     {
         *isOkPtr = false;
         return 0;
     }
 
-    return fileInfoStat.st_mtime;
+    return contextPtr->stat.st_mtim.tv_nsec;
 }
 
-size_t fileInfoGetLinkTarget(char *stringPtr, size_t stringLength, bool *isOkPtr)
+size_t fileInfoGetLinkTarget(const fileInfoContextStruct *contextPtr, char *stringPtr, size_t stringLength, bool *isOkPtr)
 {
     bool isOk = true;
 
@@ -579,7 +749,7 @@ size_t fileInfoGetLinkTarget(char *stringPtr, size_t stringLength, bool *isOkPtr
 
     ssize_t answer = 0;
 
-    if (!fileInfoPath || !stringPtr || stringLength <= 1)
+    if (!contextPtr || !contextPtr->isFileSet || !stringPtr || stringLength <= 1)
     {
         *isOkPtr = false;
         return 0;
@@ -587,8 +757,8 @@ size_t fileInfoGetLinkTarget(char *stringPtr, size_t stringLength, bool *isOkPtr
 
     memset(stringPtr, 0, stringLength);
 
-    // Длина -1 потому что readlink не создает \0 в конце
-    answer = readlink(fileInfoPath, stringPtr, stringLength - 1);
+    // Длина -1 потому что readlinkat не создает \0 в конце
+    answer = readlinkat(contextPtr->dirFd, contextPtr->filePathPtr, stringPtr, stringLength - 1);
     if (answer <= 0)
     {
         *isOkPtr = false;
@@ -599,7 +769,7 @@ size_t fileInfoGetLinkTarget(char *stringPtr, size_t stringLength, bool *isOkPtr
     return (size_t)answer;
 }
 
-uint32_t fileInfoGet512BytesBlocks(bool *isOkPtr)
+uint32_t fileInfoGet512BytesBlocks(const fileInfoContextStruct *contextPtr, bool *isOkPtr)
 {
     bool isOk = true;
 
@@ -610,20 +780,20 @@ uint32_t fileInfoGet512BytesBlocks(bool *isOkPtr)
 
     *isOkPtr = true;
 
-    if (!fileInfoPath)
+    if (!contextPtr || !contextPtr->isFileSet)
     {
         *isOkPtr = false;
         return 0;
     }
 
-    return fileInfoStat.st_blocks;
+    return contextPtr->stat.st_blocks;
 }
 
 /*
     Внешние получения строкового представления информации о файле
 */
 
-size_t fileInfoToString(const fileInfoStruct *fileInfoPtr, char *stringPtr, size_t stringLength, bool *isOkPtr)
+void fileInfoToColumns(const fileInfoStruct *fileInfoPtr, fileInfoColumnsStruct *columnsPtr, bool *isOkPtr)
 {
     bool isOk = true;
 
@@ -634,62 +804,72 @@ size_t fileInfoToString(const fileInfoStruct *fileInfoPtr, char *stringPtr, size
 
     *isOkPtr = true;
     
-    size_t answer = 0;
+    size_t used   = 0;
     size_t length = 0;
     
-    if (!fileInfoPtr || !stringPtr || stringLength < 1)
+    if (!fileInfoPtr || !columnsPtr || !fileInfoPtr->fileNamePtr)
     {
         *isOkPtr = false;
-        return 0;
+        return;
     }
-    
-    --stringLength;
 
-    #define APPEND(FUNC)  if (stringLength - answer < 0)                    \
-                          {                                                 \
-                              *isOkPtr = false;                             \
-                              return 0;                                     \
-                          }                                                 \
-                          length = FUNC;                                    \
-                          if (!*isOkPtr)                                    \
-                          {                                                 \
-                              return 0;                                     \
-                          }                                                 \
-                          answer += length;                                 \
-                          stringPtr[answer++] = FILE_INFO_TO_STRING_DELIMER;
+    #define SET_COLUMN(COLUMN, FUNC)  length = FUNC;                                                  \
+                                      if (!*isOkPtr)                                                  \
+                                      {                                                               \
+                                          return;                                                     \
+                                      }                                                               \
+                                      if (length >= FILE_INFO_COLUMNS_BUFFER_LENGTH - used)           \
+                                      {                                                               \
+                                          *isOkPtr = false;                                           \
+                                          return;                                                     \
+                                      }                                                               \
+                                      columnsPtr->fieldsList[COLUMN]  = &columnsPtr->buffer[used];    \
+                                      columnsPtr->lengthsList[COLUMN] = length;                       \
+                                      used += length + 1;
 
-    APPEND(fileInfoToStringType(fileInfoPtr->type, &stringPtr[answer], stringLength - answer, isOkPtr));
+    SET_COLUMN(fileInfoColumnType, fileInfoToStringType(fileInfoPtr->type, &columnsPtr->buffer[used], FILE_INFO_COLUMNS_BUFFER_LENGTH - used, isOkPtr));
 
-    APPEND(fileInfoToStringAccess(&fileInfoPtr->access, fileInfoPtr->type, &stringPtr[answer], stringLength - answer, isOkPtr));
+    SET_COLUMN(fileInfoColumnAccess, fileInfoToStringAccess(&fileInfoPtr->access, &columnsPtr->buffer[used], FILE_INFO_COLUMNS_BUFFER_LENGTH - used, isOkPtr));
 
-    APPEND(fileInfoToStringLinksCount(fileInfoPtr->linksCount, &stringPtr[answer], stringLength - answer, isOkPtr));
-
-    APPEND(fileInfoToStringOwnerId(fileInfoPtr->ownerId, &stringPtr[answer], stringLength - answer, isOkPtr));
-
-    APPEND(fileInfoToStringGroupId(fileInfoPtr->groupId, &stringPtr[answer], stringLength - answer, isOkPtr));
+    SET_COLUMN(fileInfoColumnLinksCount, fileInfoToStringLinksCount(fileInfoPtr->linksCount, &columnsPtr->buffer[used], FILE_INFO_COLUMNS_BUFFER_LENGTH - used, isOkPtr));
     
     if (fileInfoPtr->type != fileInfoTypeBlock && fileInfoPtr->type != fileInfoTypeChar)
     {
-        APPEND(fileInfoToStringSize(fileInfoPtr->size, &stringPtr[answer], stringLength - answer, isOkPtr));
+        SET_COLUMN(fileInfoColumnSize, fileInfoToStringSize(fileInfoPtr->size, &columnsPtr->buffer[used], FILE_INFO_COLUMNS_BUFFER_LENGTH - used, isOkPtr));
     }
     else
     {
-        APPEND(fileInfoToStringDeviceNumber(fileInfoPtr->deviceNumber, &stringPtr[answer], stringLength - answer, isOkPtr));
+        SET_COLUMN(fileInfoColumnSize, fileInfoToStringDeviceNumber(fileInfoPtr->deviceNumber, &columnsPtr->buffer[used], FILE_INFO_COLUMNS_BUFFER_LENGTH - used, isOkPtr));
     }
 
-    APPEND(fileInfoToStringTimeEdit(fileInfoPtr->timeEdit, &stringPtr[answer], stringLength - answer, isOkPtr));
+    SET_COLUMN(fileInfoColumnTimeEdit, fileInfoToStringTimeEdit(fileInfoPtr->timeEdit, &columnsPtr->buffer[used], FILE_INFO_COLUMNS_BUFFER_LENGTH - used, isOkPtr));
 
-    APPEND(snprintf(&stringPtr[answer], stringLength - answer, "%s", fileInfoPtr->fileNamePtr));
+    #undef SET_COLUMN
 
-    if (fileInfoPtr->type == fileInfoTypeLink)
+    // Имена владельца и группы не копируются, а берутся прямо из кеша имен
+    columnsPtr->fieldsList[fileInfoColumnOwner] = idNameGetUser(fileInfoPtr->ownerId, &columnsPtr->lengthsList[fileInfoColumnOwner], isOkPtr);
+    if (!*isOkPtr)
     {
-        APPEND(snprintf(&stringPtr[answer], stringLength - answer, "%s", fileInfoPtr->targetInfo.fileNamePtr));
+        return;
     }
 
-    // Перезаписываем последний разделитель на \0
-    stringPtr[--answer] = '\0';
+    columnsPtr->fieldsList[fileInfoColumnGroup] = idNameGetGroup(fileInfoPtr->groupId, &columnsPtr->lengthsList[fileInfoColumnGroup], isOkPtr);
+    if (!*isOkPtr)
+    {
+        return;
+    }
 
-    return answer;
+    columnsPtr->fieldsList[fileInfoColumnFileName]  = fileInfoPtr->fileNamePtr;
+    columnsPtr->lengthsList[fileInfoColumnFileName] = strlen(fileInfoPtr->fileNamePtr);
+
+    columnsPtr->fieldsList[fileInfoColumnTarget]  = 0;
+    columnsPtr->lengthsList[fileInfoColumnTarget] = 0;
+
+    if (fileInfoPtr->type == fileInfoTypeLink && fileInfoPtr->targetInfo.fileNamePtr)
+    {
+        columnsPtr->fieldsList[fileInfoColumnTarget]  = fileInfoPtr->targetInfo.fileNamePtr;
+        columnsPtr->lengthsList[fileInfoColumnTarget] = strlen(fileInfoPtr->targetInfo.fileNamePtr);
+    }
 }
 
 size_t fileInfoToStringType(fileInfoTypesEnum type, char *stringPtr, size_t stringLength, bool *isOkPtr)
@@ -729,7 +909,7 @@ size_t fileInfoToStringType(fileInfoTypesEnum type, char *stringPtr, size_t stri
     return answer;
 }
 
-size_t fileInfoToStringAccess(const fileInfoAccessStruct *accessPtr, fileInfoTypesEnum type, char *stringPtr, size_t stringLength, bool *isOkPtr)
+size_t fileInfoToStringAccess(const fileInfoAccessStruct *accessPtr, char *stringPtr, size_t stringLength, bool *isOkPtr)
 {
     bool isOk = true;
 
@@ -741,7 +921,6 @@ size_t fileInfoToStringAccess(const fileInfoAccessStruct *accessPtr, fileInfoTyp
     *isOkPtr = true;
     
     size_t answer = 0;
-    size_t length = 0;
 
     if (!accessPtr || !stringPtr || stringLength < 10)
     {
@@ -749,38 +928,12 @@ size_t fileInfoToStringAccess(const fileInfoAccessStruct *accessPtr, fileInfoTyp
         return 0;
     }
 
-    stringPtr[answer++] = accessPtr->owner.bits.read  ? 'r' : '-';
-    stringPtr[answer++] = accessPtr->owner.bits.write ? 'w' : '-';
-    if (accessPtr->owner.bits.special)
-    {
-        stringPtr[answer++] = accessPtr->owner.bits.execute ? 's' : 'S';
-    }
-    else
-    {
-        stringPtr[answer++] = accessPtr->owner.bits.execute ? 'x' : '-';
-    }
+    size_t index = ((size_t)accessPtr->owner.value << 8) |
+                   ((size_t)accessPtr->group.value << 4) |
+                    (size_t)accessPtr->other.value;
 
-    stringPtr[answer++] = accessPtr->group.bits.read  ? 'r' : '-';
-    stringPtr[answer++] = accessPtr->group.bits.write ? 'w' : '-';
-    if (accessPtr->group.bits.special)
-    {
-        stringPtr[answer++] = accessPtr->group.bits.execute ? 's' : 'S';
-    }
-    else
-    {
-        stringPtr[answer++] = accessPtr->group.bits.execute ? 'x' : '-';
-    }
-
-    stringPtr[answer++] = accessPtr->other.bits.read  ? 'r' : '-';
-    stringPtr[answer++] = accessPtr->other.bits.write ? 'w' : '-';
-    if (accessPtr->other.bits.special)
-    {
-        stringPtr[answer++] = accessPtr->other.bits.execute ? 't' : 'T';
-    }
-    else
-    {
-        stringPtr[answer++] = accessPtr->other.bits.execute ? 'x' : '-';
-    }
+    memcpy(stringPtr, &fileInfoAccessStringsList[index][0], 9);
+    answer = 9;
 
     stringPtr[answer] = '\0';
 
@@ -798,7 +951,7 @@ size_t fileInfoToStringLinksCount(uint32_t linksCount, char *stringPtr, size_t s
 
     *isOkPtr = true;
     
-    int answer = 0;
+    size_t answer = 0;
     
     if (!stringPtr)
     {
@@ -806,14 +959,16 @@ size_t fileInfoToStringLinksCount(uint32_t linksCount, char *stringPtr, size_t s
         return 0;
     }
     
-    answer = snprintf(stringPtr, stringLength, "%" PRIu32, linksCount);
-    if (answer < 0)
+    if (stringLength <= fileInfoDigitsCount(linksCount))
     {
         *isOkPtr = false;
         return 0;
     }
 
-    return (size_t)answer;
+    answer = fileInfoUint64ToString(linksCount, stringPtr);
+    stringPtr[answer] = '\0';
+
+    return answer;
 }
 
 
@@ -836,18 +991,15 @@ size_t fileInfoToStringOwnerId(uint32_t ownerId, char *stringPtr, size_t stringL
         return 0;
     }
 
-    struct passwd *user = 0;
+    const char *namePtr = 0;
 
-    user = getpwuid(ownerId);
-    if (user)
-    {
-        answer = snprintf(stringPtr, stringLength, "%s", user->pw_name);
-    }
-    else
+    namePtr = idNameGetUser(ownerId, 0, isOkPtr);
+    if (!*isOkPtr)
     {
-        answer = snprintf(stringPtr, stringLength, "%" PRIu32, ownerId);
+        return 0;
     }
 
+    answer = snprintf(stringPtr, stringLength, "%s", namePtr);
     if (answer < 0)
     {
         *isOkPtr = false;
@@ -876,18 +1028,15 @@ size_t fileInfoToStringGroupId(uint32_t groupId, char *stringPtr, size_t stringL
         return 0;
     }
 
-    struct group *group = 0;
+    const char *namePtr = 0;
 
-    group = getgrgid(groupId);
-    if (group)
-    {
-        answer = snprintf(stringPtr, stringLength, "%s", group->gr_name);
-    }
-    else
+    namePtr = idNameGetGroup(groupId, 0, isOkPtr);
+    if (!*isOkPtr)
     {
-        answer = snprintf(stringPtr, stringLength, "%" PRIu32, groupId);
+        return 0;
     }
 
+    answer = snprintf(stringPtr, stringLength, "%s", namePtr);
     if (answer < 0)
     {
         *isOkPtr = false;
@@ -897,7 +1046,7 @@ size_t fileInfoToStringGroupId(uint32_t groupId, char *stringPtr, size_t stringL
     return (size_t)answer;
 }
 
-size_t fileInfoToStringSize(uint32_t size, char *stringPtr, size_t stringLength, bool *isOkPtr)
+size_t fileInfoToStringSize(off_t size, char *stringPtr, size_t stringLength, bool *isOkPtr)
 {
     bool isOk = true;
 
@@ -908,7 +1057,7 @@ size_t fileInfoToStringSize(uint32_t size, char *stringPtr, size_t stringLength,
 
     *isOkPtr = true;
     
-    int answer = 0;
+    size_t answer = 0;
     
     if (!stringPtr)
     {
@@ -916,14 +1065,24 @@ size_t fileInfoToStringSize(uint32_t size, char *stringPtr, size_t stringLength,
         return 0;
     }
     
-    answer = snprintf(stringPtr, stringLength, "%" PRIu32, size);
-    if (answer < 0)
+    // Отрицательный размер возможен только у специальных файлов некоторых файловых систем
+    uint64_t absoluteSize = size < 0 ? -(uint64_t)size : (uint64_t)size;
+
+    if (stringLength <= fileInfoDigitsCount(absoluteSize) + (size < 0))
     {
         *isOkPtr = false;
         return 0;
     }
 
-    return (size_t)answer;
+    if (size < 0)
+    {
+        stringPtr[answer++] = '-';
+    }
+
+    answer += fileInfoUint64ToString(absoluteSize, &stringPtr[answer]);
+    stringPtr[answer] = '\0';
+
+    return answer;
 }
 
 size_t fileInfoToStringDeviceNumber(__uint64_t deviceNumber, char *stringPtr, size_t stringLength, bool *isOkPtr)
@@ -937,7 +1096,7 @@ size_t fileInfoToStringDeviceNumber(__uint64_t deviceNumber, char *stringPtr, si
 
     *isOkPtr = true;
     
-    int answer = 0;
+    size_t answer = 0;
     
     if (!stringPtr)
     {
@@ -945,14 +1104,23 @@ size_t fileInfoToStringDeviceNumber(__uint64_t deviceNumber, char *stringPtr, si
         return 0;
     }
     
-    answer = snprintf(stringPtr, stringLength, "%d, %d", major(deviceNumber), minor(deviceNumber));
-    if (answer < 0)
+    unsigned int majorNumber = major(deviceNumber);
+    unsigned int minorNumber = minor(deviceNumber);
+
+    // Аналог "%u, %u"
+    if (stringLength <= fileInfoDigitsCount(majorNumber) + 2 + fileInfoDigitsCount(minorNumber))
     {
         *isOkPtr = false;
         return 0;
     }
 
-    return (size_t)answer;
+    answer += fileInfoUint64ToString(majorNumber, &stringPtr[answer]);
+    stringPtr[answer++] = ',';
+    stringPtr[answer++] = ' ';
+    answer += fileInfoUint64ToString(minorNumber, &stringPtr[answer]);
+    stringPtr[answer] = '\0';
+
+    return answer;
 }
 
 size_t fileInfoToStringTimeEdit(time_t timeEdit, char *stringPtr, size_t stringLength, bool *isOkPtr)
@@ -974,20 +1142,61 @@ size_t fileInfoToStringTimeEdit(time_t timeEdit, char *stringPtr, size_t stringL
         return 0;
     }
 
-    time_t currentTime = time(NULL);
- 
+    pthread_once(&fileInfoTimeOnce, fileInfoTimeInit);
+
     // Максимальная допустимая разница между текущим временем и временем модификации файла
     static const time_t maxTimeDifference = (365.2425 * 24 * 60 * 60) / 2;
 
     // Если разница превышает максимально допустимое значение или файл модифицирован в будущем
-    if (currentTime - timeEdit > maxTimeDifference ||
-        currentTime - timeEdit < 0)
+    bool isOld = fileInfoCurrentTime - timeEdit > maxTimeDifference ||
+                 fileInfoCurrentTime - timeEdit < 0;
+
+    const fileInfoTimeCacheEntryStruct *entryPtr = fileInfoTimeCacheGet(timeEdit);
+
+    // "HH:MM" и " YYYY" имеют одинаковую длину
+    if (entryPtr && entryPtr->prefixLength + 5 < stringLength)
     {
-        answer = strftime(stringPtr, stringLength, "%b %e  %Y", localtime(&timeEdit));
+        char *positionPtr = &stringPtr[entryPtr->prefixLength];
+
+        memcpy(stringPtr, &entryPtr->prefix[0], entryPtr->prefixLength);
+
+        if (isOld)
+        {
+            positionPtr[0] = ' ';
+            memcpy(&positionPtr[1], &entryPtr->year[0], 4);
+        }
+        else
+        {
+            time_t seconds = timeEdit - entryPtr->start;
+            int    hours   = (int)(seconds / 3600);
+            int    minutes = (int)(seconds / 60 % 60);
+
+            positionPtr[0] = (char)('0' + hours   / 10);
+            positionPtr[1] = (char)('0' + hours   % 10);
+            positionPtr[2] = ':';
+            positionPtr[3] = (char)('0' + minutes / 10);
+            positionPtr[4] = (char)('0' + minutes % 10);
+        }
+        positionPtr[5] = '\0';
+
+        return entryPtr->prefixLength + 5;
+    }
+
+    struct tm timeEditLocal = {0};
+
+    if (!localtime_r(&timeEdit, &timeEditLocal))
+    {
+        *isOkPtr = false;
+        return 0;
+    }
+
+    if (isOld)
+    {
+        answer = strftime(stringPtr, stringLength, "%b %e  %Y", &timeEditLocal);
     }
     else
     {
-        answer = strftime(stringPtr, stringLength, "%b %e %H:%M", localtime(&timeEdit));
+        answer = strftime(stringPtr, stringLength, "%b %e %H:%M", &timeEditLocal);
     }
 
     if (answer < 0)
@@ -1005,3 +1214,543 @@ size_t fileInfoToStringTimeEdit(time_t timeEdit, char *stringPtr, size_t stringL
 
     return answer;
 }
+
+/*
+    Внутренние функции
+*/
+
+static int fileInfoStatFields(int dirFd, const char *filePtr, uint32_t fields, struct stat *statPtr)
+{
+#ifdef STATX_BASIC_STATS
+    static bool isStatxUnavailable = false;
+
+    if (!__atomic_load_n(&isStatxUnavailable, __ATOMIC_RELAXED))
+    {
+        struct statx fileInfo = {0};
+
+        if (!statx(dirFd, filePtr, fileInfoGetStatxFlags(), fileInfoFieldsToStatxMask(fields), &fileInfo))
+        {
+            fileInfoStatxToStat(&fileInfo, statPtr);
+
+            return 0;
+        }
+
+        if (errno != ENOSYS)
+        {
+            return -1;
+        }
+
+        __atomic_store_n(&isStatxUnavailable, true, __ATOMIC_RELAXED);
+    }
+#endif
+
+    (void)fields;
+
+    return fstatat(dirFd, filePtr, statPtr, AT_SYMLINK_NOFOLLOW);
+}
+
+static bool fileInfoContextSetFileFields(fileInfoContextStruct *contextPtr, int dirFd, const char *filePtr, uint32_t fields)
+{
+    struct stat fileInfo = {0};
+
+    if (!filePtr || fileInfoStatFields(dirFd, filePtr, fields, &fileInfo))
+    {
+        return false;
+    }
+
+    return fileInfoContextSetFileStat(contextPtr, dirFd, filePtr, &fileInfo);
+}
+
+static bool fileInfoContextSetFileStat(fileInfoContextStruct *contextPtr, int dirFd, const char *filePtr, const struct stat *statPtr)
+{
+    if (!contextPtr || !filePtr || !statPtr)
+    {
+        return false;
+    }
+
+    contextPtr->isFileSet = false;
+
+    size_t filePathLength = strlen(filePtr) + 1;
+
+    // Буфер пути переиспользуется между файлами и только растет
+    if (contextPtr->filePathCapacity < filePathLength)
+    {
+        size_t newCapacity = contextPtr->filePathCapacity ? contextPtr->filePathCapacity : FILE_INFO_PATH_CAPACITY_INITIAL;
+
+        while (newCapacity < filePathLength)
+        {
+            newCapacity *= 2;
+        }
+
+        char *newFilePathPtr = realloc(contextPtr->filePathPtr, newCapacity);
+        if (!newFilePathPtr)
+        {
+            return false;
+        }
+
+        contextPtr->filePathPtr      = newFilePathPtr;
+        contextPtr->filePathCapacity = newCapacity;
+    }
+    memcpy(contextPtr->filePathPtr, filePtr, filePathLength);
+
+    contextPtr->dirFd     = dirFd;
+    contextPtr->stat      = *statPtr;
+    contextPtr->isFileSet = true;
+
+    return true;
+}
+
+#ifdef STATX_BASIC_STATS
+static unsigned int fileInfoFieldsToStatxMask(uint32_t fields)
+{
+    unsigned int mask = STATX_TYPE;
+
+    if (fields & fileInfoFieldAccess)
+    {
+        mask |= STATX_MODE;
+    }
+    if (fields & fileInfoFieldLinksCount)
+    {
+        mask |= STATX_NLINK;
+    }
+    if (fields & fileInfoFieldOwnerId)
+    {
+        mask |= STATX_UID;
+    }
+    if (fields & fileInfoFieldGroupId)
+    {
+        mask |= STATX_GID;
+    }
+    if (fields & fileInfoFieldSize)
+    {
+        mask |= STATX_SIZE;
+    }
+    if (fields & fileInfoFieldTimeEdit)
+    {
+        mask |= STATX_MTIME;
+    }
+    if (fields & fileInfoFieldBlocks)
+    {
+        mask |= STATX_BLOCKS;
+    }
+
+    return mask;
+}
+
+static int fileInfoGetStatxFlags(void)
+{
+    int flags = AT_SYMLINK_NOFOLLOW;
+
+    if (fileInfoIsDontSyncEnabled)
+    {
+        flags |= AT_STATX_DONT_SYNC;
+    }
+
+    return flags;
+}
+
+static void fileInfoStatxToStat(const struct statx *statxPtr, struct stat *statPtr)
+{
+    memset(statPtr, 0, sizeof(struct stat));
+
+    statPtr->st_mode   = statxPtr->stx_mode;
+    statPtr->st_nlink  = statxPtr->stx_nlink;
+    statPtr->st_uid    = statxPtr->stx_uid;
+    statPtr->st_gid    = statxPtr->stx_gid;
+    statPtr->st_size   = statxPtr->stx_size;
+    statPtr->st_blocks = statxPtr->stx_blocks;
+    statPtr->st_ino    = statxPtr->stx_ino;
+    statPtr->st_dev    = makedev(statxPtr->stx_dev_major,  statxPtr->stx_dev_minor);
+    statPtr->st_rdev   = makedev(statxPtr->stx_rdev_major, statxPtr->stx_rdev_minor);
+    statPtr->st_mtime  = statxPtr->stx_mtime.tv_sec;
+
+    statPtr->st_mtim.tv_nsec = statxPtr->stx_mtime.tv_nsec;
+}
+#endif
+
+static void fileInfoGetStatAt(fileInfoContextStruct *contextPtr, int dirFd, const char *filePtr, const struct stat *statPtr, fileInfoStruct *fileInfoPtr, bool isFollowLink, bool *isOkPtr)
+{
+    *isOkPtr = true;
+
+    // Цель ссылки читается в буфер контекста
+    char *linkTargetPtr = contextPtr->linkTarget;
+
+    // Объявление переменных, используемых в cleanup
+    char *filePtrCopy1    = 0;
+    char *filePtrCopy2    = 0;
+
+    if (!filePtr || !fileInfoPtr)
+    {
+        *isOkPtr = false;
+        goto cleanup;
+    }
+
+    if (statPtr ? !fileInfoContextSetFileStat(contextPtr, dirFd, filePtr, statPtr) : !fileInfoContextSetFileAt(contextPtr, dirFd, filePtr))
+    {
+        *isOkPtr = false;
+        goto cleanup;
+    }
+    
+    memset(fileInfoPtr, 0, sizeof(fileInfoStruct));
+
+    filePtrCopy1 = strdup(filePtr);
+    if (!filePtrCopy1) 
+    {
+        *isOkPtr = false;
+        goto cleanup;
+    }
+
+    filePtrCopy2 = strdup(filePtr);
+    if (!filePtrCopy2) 
+    {
+        *isOkPtr = false;
+        goto cleanup;
+    }
+
+    char *fileNamePtr = 0;
+    char *filePathPtr = 0;
+
+    fileNamePtr = basename(filePtrCopy1);
+    filePathPtr = dirname(filePtrCopy2);
+
+    fileInfoPtr->fileNamePtr = strdup(fileNamePtr);
+    if (!fileInfoPtr->fileNamePtr)
+    {
+        *isOkPtr = false;
+        goto cleanup;
+    }
+
+    fileInfoPtr->type = fileInfoGetType(contextPtr, isOkPtr);
+    if (!*isOkPtr)
+    {
+        goto cleanup;
+    }
+
+    fileInfoPtr->access = fileInfoGetAccess(contextPtr, isOkPtr);
+    if (!*isOkPtr)
+    {
+        goto cleanup;
+    }
+
+    fileInfoPtr->linksCount = fileInfoGetLinksCount(contextPtr, isOkPtr);
+    if (!*isOkPtr)
+    {
+        goto cleanup;
+    }
+
+    fileInfoPtr->ownerId = fileInfoGetOwnerId(contextPtr, isOkPtr);
+    if (!*isOkPtr)
+    {
+        goto cleanup;
+    }
+
+    fileInfoPtr->groupId = fileInfoGetGroupId(contextPtr, isOkPtr);
+    if (!*isOkPtr)
+    {
+        goto cleanup;
+    }
+    
+    fileInfoPtr->size = fileInfoGetSize(contextPtr, isOkPtr);
+    if (!*isOkPtr)
+    {
+        goto cleanup;
+    }
+    
+    fileInfoPtr->deviceNumber = fileInfoGetDeviceNumber(contextPtr, isOkPtr);
+    if (!*isOkPtr)
+    {
+        goto cleanup;
+    }
+
+    fileInfoPtr->timeEdit = fileInfoGetTimeEdit(contextPtr, isOkPtr);
+    if (!*isOkPtr)
+    {
+        goto cleanup;
+    }
+
+    fileInfoPtr->timeEditNsec = fileInfoGetTimeEditNsec(contextPtr, isOkPtr);
+    if (!*isOkPtr)
+    {
+        goto cleanup;
+    }
+    
+    fileInfoPtr->blocks = fileInfoGet512BytesBlocks(contextPtr, isOkPtr);
+    if (!*isOkPtr)
+    {
+        goto cleanup;
+    }
+
+    if (fileInfoPtr->type == fileInfoTypeLink)
+    {
+        fileInfoGetLinkTarget(contextPtr, linkTargetPtr, FILE_INFO_TARGET_LENGTH_MAX, isOkPtr);
+        if (!*isOkPtr)
+        {
+            goto cleanup;
+        }
+
+        if (linkTargetPtr[0] == '/')
+        {
+            fileInfoPtr->targetInfo.filePathPtr = strdup(linkTargetPtr);
+            if (!fileInfoPtr->targetInfo.filePathPtr)
+            {
+                *isOkPtr = false;
+                goto cleanup;
+            }
+        }
+        else
+        {
+            size_t filePathLength = 0;
+
+            // \0 и /
+            filePathLength = strlen(filePathPtr) + strlen(linkTargetPtr) + 2;
+    
+            fileInfoPtr->targetInfo.filePathPtr = malloc(filePathLength);
+            if (!fileInfoPtr->targetInfo.filePathPtr)
+            {
+                *isOkPtr = false;
+                goto cleanup;
+            }
+            if (snprintf(fileInfoPtr->targetInfo.filePathPtr,
+                         filePathLength,
+                         "%s/%s", 
+                         filePathPtr, 
+                         linkTargetPtr) < 0)
+            {
+                *isOkPtr = false;
+                goto cleanup;
+            }
+        }
+        fileInfoPtr->targetInfo.fileNamePtr = &fileInfoPtr->targetInfo.filePathPtr[strlen(fileInfoPtr->targetInfo.filePathPtr) - strlen(linkTargetPtr)];
+
+        fileInfoPtr->targetInfo.isTargetExists = fileInfoIsExistsAt(dirFd, fileInfoPtr->targetInfo.filePathPtr, isOkPtr);
+        if (!*isOkPtr)
+        {
+            goto cleanup;
+        }
+
+        if (fileInfoPtr->targetInfo.isTargetExists)
+        {
+            // От цели ссылки нужны только тип и права доступа
+            if (!fileInfoContextSetFileFields(contextPtr, dirFd, fileInfoPtr->targetInfo.filePathPtr, fileInfoFieldType | fileInfoFieldAccess))
+            {
+                *isOkPtr = false;
+                goto cleanup;
+            }
+
+            fileInfoPtr->targetInfo.access = fileInfoGetAccess(contextPtr, isOkPtr);
+            if (!*isOkPtr)
+            {
+                goto cleanup;
+            }
+
+            fileInfoPtr->targetInfo.type = fileInfoGetType(contextPtr, isOkPtr);
+            if (!*isOkPtr)
+            {
+                goto cleanup;
+            }
+
+            char *filePathOrig = 0;
+            char *fileNameOrig = 0;
+            
+            filePathOrig = fileInfoPtr->targetInfo.filePathPtr;
+            fileNameOrig = fileInfoPtr->targetInfo.fileNamePtr;
+
+            char *fileNameBufferPtr = 0;
+            char *linkPathBufferPtr = 0;
+
+            while (fileInfoPtr->targetInfo.type == fileInfoTypeLink && isFollowLink)
+            {
+                fileInfoStruct linkInfo = {0};
+
+                fileInfoGetStatAt(contextPtr, dirFd, fileInfoPtr->targetInfo.filePathPtr, 0, &linkInfo, false, isOkPtr);
+                if (!*isOkPtr)
+                {
+                    break;
+                }
+                fileInfoPtr->targetInfo = linkInfo.targetInfo;
+
+                if (fileNameBufferPtr)
+                {
+                    free(fileNameBufferPtr);
+                }
+                fileNameBufferPtr = linkInfo.fileNamePtr;
+
+                if (linkPathBufferPtr)
+                {
+                    free(linkPathBufferPtr);
+                }
+                linkPathBufferPtr = linkInfo.targetInfo.filePathPtr;
+            }
+
+            if (fileNameBufferPtr)
+            {
+                free(fileNameBufferPtr);
+                fileNameBufferPtr = 0;
+            }
+            if (linkPathBufferPtr)
+            {
+                free(linkPathBufferPtr);
+                linkPathBufferPtr = 0;
+            }
+
+            fileInfoPtr->targetInfo.filePathPtr = filePathOrig;
+            fileInfoPtr->targetInfo.fileNamePtr = fileNameOrig;
+        }
+    }
+
+cleanup:
+
+    if (filePtrCopy1)
+    {
+        free(filePtrCopy1);
+        filePtrCopy1 = 0;
+    }
+
+    if (filePtrCopy2)
+    {
+        free(filePtrCopy2);
+        filePtrCopy2 = 0;
+    }
+
+    if (!*isOkPtr)
+    {
+        if (fileInfoPtr->fileNamePtr)
+        {
+            free(fileInfoPtr->fileNamePtr);
+            fileInfoPtr->fileNamePtr = 0;
+        }
+        if (fileInfoPtr->targetInfo.filePathPtr)
+        {
+            free(fileInfoPtr->targetInfo.filePathPtr);
+            fileInfoPtr->targetInfo.filePathPtr = 0;
+        }
+    }
+}
+
+static void fileInfoTimeInit(void)
+{
+    fileInfoCurrentTime       = time(NULL);
+    fileInfoIsMonthsListReady = true;
+
+    for (int i = 0; i < 12; ++i)
+    {
+        struct tm month = {0};
+
+        month.tm_mon  = i;
+        month.tm_mday = 1;
+        month.tm_year = 100;
+
+        fileInfoMonthsLengthList[i] = strftime(&fileInfoMonthsList[i][0], FILE_INFO_MONTH_MAX_LENGTH, "%b", &month);
+        if (!fileInfoMonthsLengthList[i])
+        {
+            fileInfoIsMonthsListReady = false;
+        }
+    }
+}
+
+static const fileInfoTimeCacheEntryStruct *fileInfoTimeCacheGet(time_t timeEdit)
+{
+    if (!fileInfoIsMonthsListReady)
+    {
+        return 0;
+    }
+
+    fileInfoTimeCacheEntryStruct *entryPtr = &fileInfoTimeCache[((uint64_t)timeEdit / 86400) % FILE_INFO_TIME_CACHE_SIZE];
+
+    if (entryPtr->start <= timeEdit && timeEdit < entryPtr->end)
+    {
+        return entryPtr;
+    }
+
+    struct tm timeLocal  = {0};
+    struct tm startLocal = {0};
+    struct tm endLocal   = {0};
+
+    if (!localtime_r(&timeEdit, &timeLocal) || timeLocal.tm_year + 1900 < 1000 || timeLocal.tm_year + 1900 > 9999)
+    {
+        return 0;
+    }
+
+    time_t start = timeEdit - (timeLocal.tm_hour * 3600 + timeLocal.tm_min * 60 + timeLocal.tm_sec);
+    time_t last  = start + 86400 - 1;
+
+    // Сутки кешируются, только если на их протяжении смещение часового пояса не меняется
+    if (!localtime_r(&start, &startLocal)                                                          ||
+        !localtime_r(&last,  &endLocal)                                                            ||
+        startLocal.tm_hour != 0  || startLocal.tm_min != 0  || startLocal.tm_sec != 0              ||
+        endLocal.tm_hour   != 23 || endLocal.tm_min   != 59 || endLocal.tm_sec   != 59             ||
+        startLocal.tm_mday != timeLocal.tm_mday || endLocal.tm_mday   != timeLocal.tm_mday         ||
+        startLocal.tm_gmtoff != timeLocal.tm_gmtoff || endLocal.tm_gmtoff != timeLocal.tm_gmtoff)
+    {
+        return 0;
+    }
+
+    fileInfoTimeCacheEntryStruct entry = {0};
+
+    entry.start = start;
+    entry.end   = last + 1;
+
+    // Аналог "%b %e "
+    memcpy(&entry.prefix[0], &fileInfoMonthsList[timeLocal.tm_mon][0], fileInfoMonthsLengthList[timeLocal.tm_mon]);
+    entry.prefixLength = fileInfoMonthsLengthList[timeLocal.tm_mon];
+
+    entry.prefix[entry.prefixLength++] = ' ';
+    entry.prefix[entry.prefixLength++] = timeLocal.tm_mday < 10 ? ' ' : (char)('0' + timeLocal.tm_mday / 10);
+    entry.prefix[entry.prefixLength++] = (char)('0' + timeLocal.tm_mday % 10);
+    entry.prefix[entry.prefixLength++] = ' ';
+
+    // Год проверен выше и состоит ровно из 4 цифр
+    int year = timeLocal.tm_year + 1900;
+
+    entry.year[0] = (char)('0' + year / 1000);
+    entry.year[1] = (char)('0' + year / 100 % 10);
+    entry.year[2] = (char)('0' + year / 10 % 10);
+    entry.year[3] = (char)('0' + year % 10);
+    entry.year[4] = '\0';
+
+    // Локальные сутки пересекают двое суток UTC, поэтому запись кладется в обе ячейки
+    fileInfoTimeCache[((uint64_t)start / 86400) % FILE_INFO_TIME_CACHE_SIZE] = entry;
+    fileInfoTimeCache[((uint64_t)last  / 86400) % FILE_INFO_TIME_CACHE_SIZE] = entry;
+
+    return &fileInfoTimeCache[((uint64_t)timeEdit / 86400) % FILE_INFO_TIME_CACHE_SIZE];
+}
+
+static size_t fileInfoDigitsCount(uint64_t value)
+{
+    // Степени 10, начиная с 10, четные, поэтому установка младшего бита не меняет количество цифр,
+    //     но исключает 0 из __builtin_clzll()
+    value |= 1;
+
+    // 1233 / 4096 ~ log10(2)
+    size_t count = ((64 - (size_t)__builtin_clzll(value)) * 1233) >> 12;
+
+    return count + 1 - (value < fileInfoPowersOf10List[count]);
+}
+
+static size_t fileInfoUint64ToString(uint64_t value, char *stringPtr)
+{
+    size_t answer   = fileInfoDigitsCount(value);
+    size_t position = answer;
+
+    while (value >= 100)
+    {
+        size_t pair = (value % 100) * 2;
+
+        value /= 100;
+        position -= 2;
+        stringPtr[position]     = fileInfoDigitsPairsList[pair];
+        stringPtr[position + 1] = fileInfoDigitsPairsList[pair + 1];
+    }
+
+    if (value >= 10)
+    {
+        stringPtr[position - 2] = fileInfoDigitsPairsList[value * 2];
+        stringPtr[position - 1] = fileInfoDigitsPairsList[value * 2 + 1];
+    }
+    else
+    {
+        stringPtr[position - 1] = (char)('0' + value);
+    }
+
+    return answer;
+}
@@ -0,0 +1,501 @@
+/// @file       idName.c
+/// @brief      См. idName.h
+/// @author     Тузиков Г.А. janisrus35@gmail.com
+
+#include "idName.h"
+#include "arena.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <pwd.h>
+#include <grp.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/*
+    Внутренние структуры
+*/
+
+/// @brief      Структура записи таблицы имен
+typedef struct idNameEntryStruct
+{
+    const char *namePtr;    ///< Указатель на имя в idNameArena. Если равен 0, запись свободна
+    size_t      nameLength; ///< Длина имени без \0
+    uint32_t    id;         ///< Id пользователя или группы
+}idNameEntryStruct;
+
+/// @brief      Структура таблицы имен
+/// @details    Хеш-таблица с открытой адресацией и линейным пробированием
+typedef struct idNameTableStruct
+{
+    idNameEntryStruct *list;     ///< Список записей
+    size_t             count;    ///< Количество занятых записей
+    size_t             capacity; ///< Вместимость list. Степень двойки
+}idNameTableStruct;
+
+/*
+    Прототипы внутренних функций
+*/
+
+/// @brief      Функция получения имени из таблицы с добавлением отсутствующего имени
+/// @param[in]  tablePtr  Указатель на таблицу
+/// @param[in]  id        Id пользователя или группы
+/// @param[in]  isGroup   Флаг поиска группы
+/// @param[out] lengthPtr Указатель на длину имени без \0. Может быть равен 0
+/// @param[out] isOkPtr   Указатель на флаг успешного выполнения операции. Может быть равен 0
+/// @return     Возвращает указатель на имя. В случае ошибки возвращает 0
+static const char *idNameGet(idNameTableStruct *tablePtr, uint32_t id, bool isGroup, size_t *lengthPtr, bool *isOkPtr);
+
+/// @brief      Функция поиска записи таблицы
+/// @param[in]  tablePtr Указатель на таблицу
+/// @param[in]  id       Id пользователя или группы
+/// @return     Возвращает указатель на запись с id или на свободную запись, куда id должен быть добавлен
+static idNameEntryStruct *idNameTableFind(const idNameTableStruct *tablePtr, uint32_t id);
+
+/// @brief      Функция увеличения вместимости таблицы вдвое
+/// @param[in]  tablePtr Указатель на таблицу
+/// @return     Возвращает true в случае успеха. В противном случае, возвращает false
+static bool idNameTableGrow(idNameTableStruct *tablePtr);
+
+/// @brief      Функция загрузки имен из /etc/passwd и /etc/group
+/// @details    Данная функция выполняется один раз, при первом обращении к кешу.
+///                 Файл разбирается, только если idNameIsFilesFirst() для него возвращает true
+static void idNameLoadFiles(void);
+
+/// @brief      Функция проверки, что files является первым источником базы NSS
+/// @details    Данная функция выполняет разбор ID_NAME_NSSWITCH_PATH.
+///                 Если files стоит первым и за ним не следует действие в [],
+///                 найденная в файле запись является ответом NSS
+/// @param[in]  databasePtr Указатель на имя базы: passwd или group
+/// @return     Возвращает true, если файл можно разбирать напрямую.
+///                 В противном случае, возвращает false
+static bool idNameIsFilesFirst(const char *databasePtr);
+
+/// @brief      Функция разбора файла в формате /etc/passwd
+/// @details    Данная функция выполняет отображение файла в память и добавление
+///                 в таблицу пар имя-id из первого и третьего полей каждой строки.
+///                 Для повторяющихся id используется первая запись, как и в NSS
+/// @param[in]  tablePtr Указатель на таблицу
+/// @param[in]  filePtr  Указатель на путь к файлу
+static void idNameLoadFile(idNameTableStruct *tablePtr, const char *filePtr);
+
+/// @brief      Функция добавления имени в таблицу
+/// @param[in]  tablePtr   Указатель на таблицу
+/// @param[in]  id         Id пользователя или группы
+/// @param[in]  namePtr    Указатель на имя
+/// @param[in]  nameLength Длина имени без \0
+/// @return     Возвращает указатель на запись с id. В случае ошибки возвращает 0
+static idNameEntryStruct *idNameTableInsert(idNameTableStruct *tablePtr, uint32_t id, const char *namePtr, size_t nameLength);
+
+/// @brief      Функция получения имени у NSS
+/// @param[in]  id           Id пользователя или группы
+/// @param[in]  isGroup      Флаг поиска группы
+/// @param[out] stringPtr    Указатель на строку, куда будет записан результат с \0
+/// @param[in]  stringLength Длина строки stringPtr
+/// @return     Возвращает длину имени без \0.
+///                 Если имя не найдено или не поместилось в stringPtr, возвращает 0
+static size_t idNameResolve(uint32_t id, bool isGroup, char *stringPtr, size_t stringLength);
+
+/*
+    Внутренние переменные
+*/
+
+/// @brief      Мьютекс доступа к кешу
+pthread_mutex_t idNameMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/// @brief      Арена для хранения имен
+arenaStruct idNameArena = {0};
+
+/// @brief      Таблица имен пользователей
+idNameTableStruct idNameUsers = {0};
+
+/// @brief      Таблица имен групп
+idNameTableStruct idNameGroups = {0};
+
+/// @brief      Флаг выполненной загрузки имен из файлов
+bool idNameIsFilesLoaded = false;
+
+/*
+    Переменные
+*/
+
+bool idNameIsFilesParserEnabled = true;
+
+/*
+    Функции
+*/
+
+const char *idNameGetUser(uint32_t uid, size_t *lengthPtr, bool *isOkPtr)
+{
+    return idNameGet(&idNameUsers, uid, false, lengthPtr, isOkPtr);
+}
+
+const char *idNameGetGroup(uint32_t gid, size_t *lengthPtr, bool *isOkPtr)
+{
+    return idNameGet(&idNameGroups, gid, true, lengthPtr, isOkPtr);
+}
+
+void idNameClear(void)
+{
+    pthread_mutex_lock(&idNameMutex);
+
+    if (idNameUsers.list)
+    {
+        free(idNameUsers.list);
+    }
+    if (idNameGroups.list)
+    {
+        free(idNameGroups.list);
+    }
+
+    memset(&idNameUsers,  0, sizeof(idNameTableStruct));
+    memset(&idNameGroups, 0, sizeof(idNameTableStruct));
+
+    idNameIsFilesLoaded = false;
+
+    arenaClear(&idNameArena);
+
+    pthread_mutex_unlock(&idNameMutex);
+}
+
+/*
+    Внутренние функции
+*/
+
+static const char *idNameGet(idNameTableStruct *tablePtr, uint32_t id, bool isGroup, size_t *lengthPtr, bool *isOkPtr)
+{
+    bool isOk = true;
+
+    if (!isOkPtr)
+    {
+        isOkPtr = &isOk;
+    }
+
+    *isOkPtr = true;
+
+    const char *answer = 0;
+
+    pthread_mutex_lock(&idNameMutex);
+
+    if (!idNameIsFilesLoaded)
+    {
+        idNameIsFilesLoaded = true;
+        idNameLoadFiles();
+    }
+
+    idNameEntryStruct *entryPtr = tablePtr->capacity ? idNameTableFind(tablePtr, id) : 0;
+
+    if (!entryPtr || !entryPtr->namePtr)
+    {
+        char   name[ID_NAME_NSS_BUFFER_SIZE];
+        size_t nameLength = 0;
+
+        nameLength = idNameResolve(id, isGroup, &name[0], sizeof(name));
+        if (!nameLength)
+        {
+            int length = snprintf(&name[0], sizeof(name), "%" PRIu32, id);
+            if (length < 0)
+            {
+                *isOkPtr = false;
+                goto cleanup;
+            }
+            nameLength = (size_t)length;
+        }
+
+        entryPtr = idNameTableInsert(tablePtr, id, &name[0], nameLength);
+        if (!entryPtr)
+        {
+            *isOkPtr = false;
+            goto cleanup;
+        }
+    }
+
+    answer = entryPtr->namePtr;
+
+    if (lengthPtr)
+    {
+        *lengthPtr = entryPtr->nameLength;
+    }
+
+cleanup:
+
+    pthread_mutex_unlock(&idNameMutex);
+
+    return answer;
+}
+
+static void idNameLoadFiles(void)
+{
+    if (!idNameIsFilesParserEnabled)
+    {
+        return;
+    }
+
+    if (idNameIsFilesFirst("passwd"))
+    {
+        idNameLoadFile(&idNameUsers, ID_NAME_PASSWD_PATH);
+    }
+
+    if (idNameIsFilesFirst("group"))
+    {
+        idNameLoadFile(&idNameGroups, ID_NAME_GROUP_PATH);
+    }
+}
+
+static bool idNameIsFilesFirst(const char *databasePtr)
+{
+    bool  answer       = false;
+    FILE *nsswitchPtr  = 0;
+    char  line[ID_NAME_NSS_BUFFER_SIZE];
+    size_t databaseLength = strlen(databasePtr);
+
+    nsswitchPtr = fopen(ID_NAME_NSSWITCH_PATH, "re");
+    if (!nsswitchPtr)
+    {
+        return false;
+    }
+
+    while (fgets(&line[0], sizeof(line), nsswitchPtr))
+    {
+        char *positionPtr = &line[0];
+
+        positionPtr += strspn(positionPtr, " \t");
+
+        if (strncmp(positionPtr, databasePtr, databaseLength) != 0)
+        {
+            continue;
+        }
+        positionPtr += databaseLength;
+        positionPtr += strspn(positionPtr, " \t");
+
+        if (*positionPtr != ':')
+        {
+            continue;
+        }
+        ++positionPtr;
+
+        char *tokenSave   = 0;
+        char *sourcePtr   = strtok_r(positionPtr, " \t\n#", &tokenSave);
+        char *nextPtr     = strtok_r(NULL,        " \t\n#", &tokenSave);
+
+        // Действие в [] может изменить поведение при успешном поиске в files
+        answer = sourcePtr && strcmp(sourcePtr, "files") == 0 && (!nextPtr || nextPtr[0] != '[');
+        break;
+    }
+
+    fclose(nsswitchPtr);
+
+    return answer;
+}
+
+static void idNameLoadFile(idNameTableStruct *tablePtr, const char *filePtr)
+{
+    int          fd        = -1;
+    struct stat  fileInfo  = {0};
+    const char  *dataPtr   = MAP_FAILED;
+
+    fd = open(filePtr, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return;
+    }
+
+    if (fstat(fd, &fileInfo) || fileInfo.st_size <= 0)
+    {
+        close(fd);
+        return;
+    }
+
+    dataPtr = mmap(0, (size_t)fileInfo.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (dataPtr == MAP_FAILED)
+    {
+        return;
+    }
+
+    const char *positionPtr = dataPtr;
+    const char *endPtr      = dataPtr + fileInfo.st_size;
+
+    while (positionPtr < endPtr)
+    {
+        const char *lineEndPtr = memchr(positionPtr, '\n', (size_t)(endPtr - positionPtr));
+        if (!lineEndPtr)
+        {
+            lineEndPtr = endPtr;
+        }
+
+        // Поля: имя:пароль:id:...
+        const char *nameEndPtr     = memchr(positionPtr, ':', (size_t)(lineEndPtr - positionPtr));
+        const char *passwordEndPtr = nameEndPtr ? memchr(nameEndPtr + 1, ':', (size_t)(lineEndPtr - nameEndPtr - 1)) : 0;
+
+        // Записи NIS (+/-) и комментарии обрабатываются NSS
+        if (passwordEndPtr && nameEndPtr != positionPtr && positionPtr[0] != '+' && positionPtr[0] != '-' && positionPtr[0] != '#')
+        {
+            const char *idPtr   = passwordEndPtr + 1;
+            uint64_t    id      = 0;
+            bool        isValid = idPtr < lineEndPtr && *idPtr != ':';
+
+            for (; idPtr < lineEndPtr && *idPtr != ':'; ++idPtr)
+            {
+                if (*idPtr < '0' || *idPtr > '9' || id > UINT32_MAX)
+                {
+                    isValid = false;
+                    break;
+                }
+                id = id * 10 + (uint64_t)(*idPtr - '0');
+            }
+
+            if (isValid && id <= UINT32_MAX)
+            {
+                idNameEntryStruct *entryPtr = tablePtr->capacity ? idNameTableFind(tablePtr, (uint32_t)id) : 0;
+
+                if (!entryPtr || !entryPtr->namePtr)
+                {
+                    if (!idNameTableInsert(tablePtr, (uint32_t)id, positionPtr, (size_t)(nameEndPtr - positionPtr)))
+                    {
+                        break;
+                    }
+                }
+            }
+        }
+
+        positionPtr = lineEndPtr + 1;
+    }
+
+    munmap((void *)dataPtr, (size_t)fileInfo.st_size);
+}
+
+static idNameEntryStruct *idNameTableInsert(idNameTableStruct *tablePtr, uint32_t id, const char *namePtr, size_t nameLength)
+{
+    bool isOk = true;
+
+    // Таблица заполняется не более чем на 3/4
+    if ((tablePtr->count + 1) * 4 > tablePtr->capacity * 3 && !idNameTableGrow(tablePtr))
+    {
+        return 0;
+    }
+
+    idNameEntryStruct *entryPtr = idNameTableFind(tablePtr, id);
+
+    if (entryPtr->namePtr)
+    {
+        return entryPtr;
+    }
+
+    entryPtr->namePtr = arenaStringCopy(&idNameArena, namePtr, nameLength, &isOk);
+    if (!isOk)
+    {
+        entryPtr->namePtr = 0;
+        return 0;
+    }
+    entryPtr->nameLength = nameLength;
+    entryPtr->id         = id;
+
+    ++tablePtr->count;
+
+    return entryPtr;
+}
+
+static idNameEntryStruct *idNameTableFind(const idNameTableStruct *tablePtr, uint32_t id)
+{
+    size_t mask  = tablePtr->capacity - 1;
+    size_t index = (size_t)(id * UINT32_C(2654435761)) & mask;
+
+    while (tablePtr->list[index].namePtr && tablePtr->list[index].id != id)
+    {
+        index = (index + 1) & mask;
+    }
+
+    return &tablePtr->list[index];
+}
+
+static bool idNameTableGrow(idNameTableStruct *tablePtr)
+{
+    idNameTableStruct newTable = {0};
+
+    newTable.capacity = tablePtr->capacity ? tablePtr->capacity * 2 : ID_NAME_TABLE_CAPACITY_INITIAL;
+
+    newTable.list = calloc(newTable.capacity, sizeof(idNameEntryStruct));
+    if (!newTable.list)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < tablePtr->capacity; ++i)
+    {
+        if (tablePtr->list[i].namePtr)
+        {
+            *idNameTableFind(&newTable, tablePtr->list[i].id) = tablePtr->list[i];
+            ++newTable.count;
+        }
+    }
+
+    if (tablePtr->list)
+    {
+        free(tablePtr->list);
+    }
+
+    *tablePtr = newTable;
+
+    return true;
+}
+
+static size_t idNameResolve(uint32_t id, bool isGroup, char *stringPtr, size_t stringLength)
+{
+    char    buffer[ID_NAME_NSS_BUFFER_SIZE];
+    char   *bufferPtr     = &buffer[0];
+    size_t  bufferSize    = sizeof(buffer);
+    char   *heapBufferPtr = 0;
+    size_t  answer        = 0;
+
+    struct passwd  user     = {0};
+    struct passwd *userPtr  = 0;
+    struct group   group    = {0};
+    struct group  *groupPtr = 0;
+
+    // Если записи не хватает буфера на стеке, буфер выделяется в куче
+    while ((isGroup ? getgrgid_r(id, &group, bufferPtr, bufferSize, &groupPtr) :
+                      getpwuid_r(id, &user,  bufferPtr, bufferSize, &userPtr)) == ERANGE)
+    {
+        bufferSize *= 2;
+
+        char *newBufferPtr = realloc(heapBufferPtr, bufferSize);
+        if (!newBufferPtr)
+        {
+            userPtr  = 0;
+            groupPtr = 0;
+            break;
+        }
+        heapBufferPtr = newBufferPtr;
+        bufferPtr     = heapBufferPtr;
+    }
+
+    const char *namePtr = isGroup ? (groupPtr ? groupPtr->gr_name : 0) :
+                                    (userPtr  ? userPtr->pw_name  : 0);
+
+    if (namePtr)
+    {
+        answer = strlen(namePtr);
+        if (answer < stringLength)
+        {
+            memcpy(stringPtr, namePtr, answer + 1);
+        }
+        else
+        {
+            answer = 0;
+        }
+    }
+
+    if (heapBufferPtr)
+    {
+        free(heapBufferPtr);
+        heapBufferPtr = 0;
+    }
+
+    return answer;
+}
@@ -4,17 +4,100 @@
 
 #include "jls.h"
 #include "fileInfo.h"
+#include "dirReader.h"
+#include "arena.h"
+#include "output.h"
 #include <stdio.h>
 #include <string.h>
-#include <dirent.h>
-#include <linux/limits.h>
 #include <inttypes.h>
 #include <stddef.h>
 #include <wchar.h>
 #include <wctype.h>
+#include <langinfo.h>
+#include <locale.h>
 #include <errno.h>
 #include <sys/ioctl.h>
 #include <unistd.h>
+#include <pthread.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/*
+    Внутренние перечисления
+*/
+
+/// @brief      Флаги классов байтов для экранирования в jlsMakeStringSafe()
+typedef enum jlsQuoteClassesEnum
+{
+    jlsQuoteClassUnsafe        = 1, ///< Небезопасный ASCII символ
+    jlsQuoteClassMultibyte     = 2, ///< Байт символа не ASCII, требует проверки jlsCheckIsUnsafe()
+    jlsQuoteClassSingleQuote   = 4, ///< Одинарная кавычка
+    jlsQuoteClassDoubleSpecial = 8  ///< Символ, запрещающий экранирование двойными кавычками
+}jlsQuoteClassesEnum;
+
+/*
+    Внутренние структуры
+*/
+
+/// @brief      Структура общих данных потоков получения информации о файлах
+typedef struct jlsStatWorkStruct
+{
+    int                    dirFd;        ///< Дескриптор директории
+    const char *const     *namesList;    ///< Список имен файлов
+    fileInfoStruct *const *fileInfoList; ///< Список указателей на информацию о файлах
+    size_t                 count;        ///< Количество файлов
+    size_t                 next;         ///< Индекс следующей необработанной порции. Изменяется атомарно
+    bool                   isOk;         ///< Флаг отсутствия ошибок. Изменяется атомарно
+}jlsStatWorkStruct;
+
+/// @brief      Структура ключа сортировки файла
+typedef struct jlsSortKeyStruct
+{
+    const char     *keyPtr;      ///< Ключ сортировки: результат strxfrm() или само имя файла при побайтовом порядке
+    size_t          keyLength;   ///< Длина ключа сортировки без \0
+    fileInfoStruct *fileInfoPtr; ///< Указатель на информацию о файле
+}jlsSortKeyStruct;
+
+/// @brief      Структура буфера сборки ключа сортировки
+/// @note       Обнуленная структура является пустым буфером
+typedef struct jlsSortKeyBufferStruct
+{
+    char   *dataPtr; ///< Данные ключа
+    size_t  size;    ///< Размер буфера
+    size_t  length;  ///< Длина собранного ключа
+}jlsSortKeyBufferStruct;
+
+/// @brief      Структура общих данных потоков параллельной сортировки
+typedef struct jlsSortWorkStruct
+{
+    const jlsSortSpecStruct *specPtr;         ///< Указатель на описание сортировки. Если равен 0, файлы сортируются по имени
+    fileInfoStruct         **filesList;       ///< Сортируемый список файлов. В него записывается результат
+    jlsSortKeyStruct        *keysList;        ///< Список ключей сортировки
+    jlsSortKeyStruct        *tempList;        ///< Вспомогательный список ключей
+    size_t                   count;           ///< Количество файлов
+    size_t                   partsCount;      ///< Количество частей
+    size_t                  *boundsList;      ///< Границы частей слияния: для части p в отсортированной части c
+                                              ///<     это [boundsList[c * (partsCount + 1) + p]; boundsList[c * (partsCount + 1) + p + 1])
+    bool                     isByteCollation; ///< Флаг побайтового порядка сортировки
+    bool                     isDescend;       ///< Флаг сортировки по убыванию
+}jlsSortWorkStruct;
+
+/// @brief      Структура файла, отобранного jlsPrintDirTop()
+typedef struct jlsTopEntryStruct
+{
+    jlsSortKeyBufferStruct key;      ///< Ключ сортировки файла
+    fileInfoStruct         fileInfo; ///< Информация о файле. Если информация о файлах не запрашивалась, заполнено только имя
+}jlsTopEntryStruct;
+
+/// @brief      Структура части параллельной сортировки
+typedef struct jlsSortPartStruct
+{
+    jlsSortWorkStruct *workPtr;   ///< Указатель на общие данные
+    size_t             index;     ///< Номер части
+    arenaStruct        keysArena; ///< Арена ключей сортировки части
+    bool               isOk;      ///< Флаг успешного выполнения
+}jlsSortPartStruct;
 
 /*
     Прототипы внутренних функций
@@ -28,51 +111,393 @@
 ///                 Результат записывается в jlsMaxVisibleChars
 static void jlsUpdateMaxVisibleChars(void);
 
-/// @brief      Функция установки пути, где находятся файлы
-/// @details    Данная функция выполняет запись pathPtr в bufferPtr размером bufferSize
-/// @param[in]  pathPtr    Указатель на путь к файлам
-/// @param[in]  bufferPtr  Указатель на буфер, куда будет записан pathPtr. Включая \0
-/// @param[in]  bufferSize Размер bufferPtr
-/// @param[out] isOkPtr    Указатель на флаг успешного выполнения операции. Может быть равен 0
-/// @return     Возвращает количество записаных в pathPtr байт
-static size_t jlsPathSet(const char *pathPtr, char *bufferPtr, size_t bufferSize, bool *isOkPtr);
-
-/// @brief      Функция добавления имени файла к пути
-/// @details    Данная функция выполняет запись filePtr в bufferPtr размером bufferSize в позицию bufferLength
-/// @param[in]  filePtr      Указатель на файл
-/// @param[in]  bufferPtr    Указатель на буфер, куда будет записан filePtr. Включая \0
-/// @param[in]  bufferLength Позиция, с которой нужно записать filePtr
-/// @param[in]  bufferSize   Размер bufferPtr
+/// @brief      Функция обновления максимальных размеров полей информации о файле
+/// @details    Данная функция выполняет получение строкового представления fileInfoPtr
+///                 и расширение полей alignmentPtr, если соответствующее поле fileInfoPtr длиннее
+/// @param[in]  alignmentPtr Указатель на структуру максимальных размеров полей информации о файле
+/// @param[in]  fileInfoPtr  Указатель на информацию о файле
 /// @param[out] isOkPtr      Указатель на флаг успешного выполнения операции. Может быть равен 0
-/// @return     Возвращает длину bufferPtr. Включая \0
-static size_t jlsPathAppend(const char *filePtr, char *bufferPtr, size_t bufferLength, size_t bufferSize, bool *isOkPtr);
+static void jlsAlignmentUpdate(jlsAlignmentStruct *alignmentPtr, const fileInfoStruct *fileInfoPtr, bool *isOkPtr);
 
 /// @brief      Функция сортировки по возрастанию
-/// @param[in]  a Первый элемент
-/// @param[in]  b Второй элемент
-/// @return     Возвращает результат выполнения strcmp(a, b)
-static int jlsFilesListCompareAscend(const void *a, const void *b);
-
-/// @brief      Функция сортировки по убыванию
-/// @param[in]  a Первый элемент
-/// @param[in]  b Второй элемент
-/// @return     Возвращает результат выполнения jlsFilesListCompareAscend(b, a)
-static int jlsFilesListCompareDescend(const void *a, const void *b);
+/// @details    Ключи сравниваются memcmp(), что эквивалентно strcoll() для исходных имен файлов
+/// @param[in]  a Первый элемент, jlsSortKeyStruct
+/// @param[in]  b Второй элемент, jlsSortKeyStruct
+/// @return     Возвращает результат выполнения jlsSortKeysCompare(a, b, 0)
+static int jlsSortKeysCompareAscend(const void *a, const void *b);
+
+/// @brief      Функция сравнения ключей сортировки, начиная с байта depth
+/// @param[in]  keyAPtr Указатель на первый ключ
+/// @param[in]  keyBPtr Указатель на второй ключ
+/// @param[in]  depth   Индекс первого сравниваемого байта. Байты до depth у ключей должны совпадать
+/// @return     Возвращает отрицательное число, 0 или положительное число, если первый ключ
+///                 меньше, равен или больше второго соответственно
+static int jlsSortKeysCompare(const jlsSortKeyStruct *keyAPtr, const jlsSortKeyStruct *keyBPtr, size_t depth);
+
+
+/// @brief      Функция получения ключей сортировки
+/// @details    Данная функция выполняет сборку полей specPtr и имени каждого файла в один ключ.
+///                 При сортировке по имени с побайтовым порядком ключом является само имя файла
+/// @param[in]  filesList       Список файлов
+/// @param[out] keysList        Список ключей
+/// @param[in]  count           Количество файлов
+/// @param[in]  specPtr         Указатель на описание сортировки. Если равен 0, файлы сортируются по имени
+/// @param[in]  isByteCollation Флаг побайтового порядка сортировки
+/// @param[in]  keysArenaPtr    Указатель на арену, в которой размещаются ключи
+/// @param[out] isOkPtr         Указатель на флаг успешного выполнения операции
+static void jlsSortKeysFill(fileInfoStruct *const *filesList, jlsSortKeyStruct *keysList, size_t count, const jlsSortSpecStruct *specPtr,
+                            bool isByteCollation, arenaStruct *keysArenaPtr, bool *isOkPtr);
+
+/// @brief      Функция сборки ключа сортировки файла
+/// @details    Данная функция выполняет запись в bufferPtr полей specPtr и имени файла
+/// @param[in]  bufferPtr       Указатель на буфер ключа. Предыдущее содержимое отбрасывается
+/// @param[in]  fileInfoPtr     Указатель на информацию о файле
+/// @param[in]  specPtr         Указатель на описание сортировки. Если равен 0, ключом является имя файла
+/// @param[in]  isByteCollation Флаг побайтового порядка сортировки
+/// @param[out] isOkPtr         Указатель на флаг успешного выполнения операции
+static void jlsSortKeyBuild(jlsSortKeyBufferStruct *bufferPtr, const fileInfoStruct *fileInfoPtr, const jlsSortSpecStruct *specPtr,
+                            bool isByteCollation, bool *isOkPtr);
+
+/// @brief      Функция добавления поля файла к ключу сортировки
+/// @details    Время и размер записываются так, чтобы новые и большие файлы были меньше
+/// @param[in]  bufferPtr       Указатель на буфер ключа
+/// @param[in]  fileInfoPtr     Указатель на информацию о файле
+/// @param[in]  field           Поле сортировки
+/// @param[in]  isReversed      Флаг обратного порядка поля
+/// @param[in]  isByteCollation Флаг побайтового порядка сортировки
+/// @param[out] isOkPtr         Указатель на флаг успешного выполнения операции
+static void jlsSortKeyAppendField(jlsSortKeyBufferStruct *bufferPtr, const fileInfoStruct *fileInfoPtr, jlsSortFieldsEnum field,
+                                  bool isReversed, bool isByteCollation, bool *isOkPtr);
+
+/// @brief      Функция добавления строки к ключу сортировки
+/// @details    Строка преобразуется strxfrm() или копируется при побайтовом порядке и завершается байтом 0,
+///                 который меньше любого байта строки, поэтому строка-префикс оказывается меньше.
+///                 В обратном порядке все байты, включая завершающий, инвертируются
+/// @param[in]  bufferPtr       Указатель на буфер ключа
+/// @param[in]  stringPtr       Указатель на строку
+/// @param[in]  isReversed      Флаг обратного порядка
+/// @param[in]  isByteCollation Флаг побайтового порядка сортировки
+/// @param[out] isOkPtr         Указатель на флаг успешного выполнения операции
+static void jlsSortKeyAppendString(jlsSortKeyBufferStruct *bufferPtr, const char *stringPtr, bool isReversed, bool isByteCollation, bool *isOkPtr);
+
+/// @brief      Функция добавления имени в естественном порядке к ключу сортировки
+/// @details    Имя один раз разбивается на чередующиеся текст и числа, чтобы при сравнении memcmp() числа не разбирались заново.
+///                 Текст записывается побайтово без учета локали, число - маркером, длиной без ведущих нулей и цифрами,
+///                 поэтому более длинное число больше. Конец имени меньше числа, число меньше любого символа текста
+/// @param[in]  bufferPtr  Указатель на буфер ключа
+/// @param[in]  stringPtr  Указатель на строку
+/// @param[in]  isReversed Флаг обратного порядка
+/// @param[out] isOkPtr    Указатель на флаг успешного выполнения операции
+static void jlsSortKeyAppendVersion(jlsSortKeyBufferStruct *bufferPtr, const char *stringPtr, bool isReversed, bool *isOkPtr);
+
+/// @brief      Функция добавления числа к ключу сортировки
+/// @details    Число записывается в порядке от старшего байта, чтобы memcmp() сравнивала его как число
+/// @param[in]  bufferPtr  Указатель на буфер ключа
+/// @param[in]  value      Число
+/// @param[in]  isReversed Флаг обратного порядка
+/// @param[out] isOkPtr    Указатель на флаг успешного выполнения операции
+static void jlsSortKeyAppendNumber(jlsSortKeyBufferStruct *bufferPtr, uint64_t value, bool isReversed, bool *isOkPtr);
+
+/// @brief      Функция резервирования места в буфере ключа сортировки
+/// @param[in]  bufferPtr Указатель на буфер ключа
+/// @param[in]  size      Количество байт, которое должно быть доступно после конца ключа
+/// @param[out] isOkPtr   Указатель на флаг успешного выполнения операции
+static void jlsSortKeyBufferReserve(jlsSortKeyBufferStruct *bufferPtr, size_t size, bool *isOkPtr);
+
+/// @brief      Функция сортировки ключей по возрастанию
+/// @details    При побайтовом порядке используется jlsRadixSortKeys(), иначе - qsort()
+/// @param[in]  keysList        Список ключей. Результат записывается в него же
+/// @param[out] tempList        Вспомогательный список не меньше count ключей
+/// @param[in]  count           Количество ключей
+/// @param[in]  isByteCollation Флаг побайтового порядка сортировки
+static void jlsSortKeysAscend(jlsSortKeyStruct *keysList, jlsSortKeyStruct *tempList, size_t count, bool isByteCollation);
+
+/// @brief      Функция параллельной сортировки списка файлов
+/// @details    Данная функция выполняет сортировку с регулярной выборкой: <br>
+///                 1) Список делится на threadsCount частей, каждая часть сортируется в своем потоке jlsSortChunkWorker() <br>
+///                 2) Из каждой отсортированной части берутся threadsCount равноотстоящих ключей,
+///                     по ним выбираются границы частей слияния <br>
+///                 3) Каждая часть слияния собирается из всех отсортированных частей в своем потоке jlsSortMergeWorker()
+/// @param[in]  filesListPtr    Указатель на список файлов
+/// @param[in]  specPtr         Указатель на описание сортировки. Если равен 0, файлы сортируются по имени
+/// @param[in]  threadsCount    Количество потоков
+/// @param[in]  isByteCollation Флаг побайтового порядка сортировки
+/// @param[in]  isDescend       Флаг сортировки по убыванию
+/// @param[out] isOkPtr         Указатель на флаг успешного выполнения операции
+static void jlsSortFilesListParallel(jlsFilesListStruct *filesListPtr, const jlsSortSpecStruct *specPtr, size_t threadsCount,
+                                     bool isByteCollation, bool isDescend, bool *isOkPtr);
+
+/// @brief      Функция потока получения ключей и сортировки одной части списка файлов
+/// @param[in]  partPtr Указатель на jlsSortPartStruct
+/// @return     Возвращает 0
+static void *jlsSortChunkWorker(void *partPtr);
+
+/// @brief      Функция потока слияния одной части списка файлов
+/// @details    Данная функция выполняет слияние диапазонов всех отсортированных частей, относящихся к части слияния,
+///                 при помощи двоичной кучи и записывает результат сразу в список файлов
+/// @param[in]  partPtr Указатель на jlsSortPartStruct
+/// @return     Возвращает 0
+static void *jlsSortMergeWorker(void *partPtr);
+
+/// @brief      Функция просеивания вниз элемента двоичной кучи слияния
+/// @details    Куча хранит номера отсортированных частей, упорядоченные по их текущим ключам keysList[cursorsList[номер]]
+/// @param[in]  keysList    Список ключей
+/// @param[in]  cursorsList Список индексов текущих ключей отсортированных частей
+/// @param[in]  heapList    Куча номеров отсортированных частей. Результат записывается в нее же
+/// @param[in]  count       Количество элементов кучи
+/// @param[in]  start       Индекс просеиваемого элемента
+static void jlsSortHeapSiftDown(const jlsSortKeyStruct *keysList, const size_t *cursorsList, size_t *heapList, size_t count, size_t start);
+
+/// @brief      Функция выполнения частей параллельной сортировки в нескольких потоках
+/// @details    Данная функция выполняет запуск потока worker() для каждой части, кроме первой,
+///                 которую выполняет сама, и дожидается завершения всех потоков.
+///                 Если поток создать не удалось, его часть выполняется в текущем потоке
+/// @param[in]  worker     Функция потока
+/// @param[in]  partsList  Список частей
+/// @param[in]  partsCount Количество частей
+static void jlsSortRunParts(void *(*worker)(void *), jlsSortPartStruct *partsList, size_t partsCount);
+
+/// @brief      Функция поиска первого ключа, не меньшего заданного
+/// @param[in]  keysList Отсортированный по возрастанию список ключей
+/// @param[in]  count    Количество ключей
+/// @param[in]  keyPtr   Указатель на искомый ключ
+/// @return     Возвращает индекс найденного ключа или count, если такого ключа нет
+static size_t jlsSortKeysLowerBound(const jlsSortKeyStruct *keysList, size_t count, const jlsSortKeyStruct *keyPtr);
+
+/// @brief      Функция сравнения ключей файлов, отобранных jlsPrintDirTop()
+/// @param[in]  keyAPtr   Указатель на первый ключ
+/// @param[in]  keyBPtr   Указатель на второй ключ
+/// @param[in]  isDescend Флаг сортировки по убыванию
+/// @return     Возвращает отрицательное число, если первый файл выводится раньше второго, 0 при равенстве ключей
+///                 и положительное число в остальных случаях
+static int jlsTopKeysCompare(const jlsSortKeyBufferStruct *keyAPtr, const jlsSortKeyBufferStruct *keyBPtr, bool isDescend);
+
+/// @brief      Функция просеивания вниз пирамиды отобранных файлов
+/// @details    В вершине пирамиды находится файл, который выводится последним, то есть первый кандидат на вытеснение
+/// @param[in]  entriesList Список отобранных файлов
+/// @param[in]  heapList    Пирамида индексов entriesList
+/// @param[in]  count       Количество элементов пирамиды
+/// @param[in]  start       Индекс просеиваемого элемента
+/// @param[in]  isDescend   Флаг сортировки по убыванию
+static void jlsTopHeapSiftDown(const jlsTopEntryStruct *entriesList, size_t *heapList, size_t count, size_t start, bool isDescend);
+
+/// @brief      Функция получения количества потоков
+/// @return     Возвращает jlsStatThreadsCount или количество доступных процессоров, если он равен 0,
+///                 но не более JLS_STAT_THREADS_MAX
+static size_t jlsGetThreadsCount(void);
+
+/// @brief      Функция проверки побайтового порядка сортировки
+/// @return     Возвращает true, если LC_COLLATE - C или POSIX. В этом случае strcoll() эквивалентна strcmp()
+static bool jlsCheckIsByteCollation(void);
+
+/// @brief      Функция поразрядной сортировки ключей по возрастанию
+/// @details    Данная функция выполняет MSD radix sort: ключи распределяются по корзинам по значению байта depth,
+///                 после чего каждая корзина сортируется по следующему байту. Корзины меньше
+///                 JLS_RADIX_SORT_THRESHOLD ключей сортируются jlsInsertionSortKeys()
+/// @param[in]  keysList Список ключей. Результат записывается в него же
+/// @param[out] tempList Вспомогательный список не меньше count ключей
+/// @param[in]  count    Количество ключей
+/// @param[in]  depth    Индекс байта, по которому выполняется распределение. Байты до depth у всех ключей совпадают
+static void jlsRadixSortKeys(jlsSortKeyStruct *keysList, jlsSortKeyStruct *tempList, size_t count, size_t depth);
+
+/// @brief      Функция сортировки ключей вставками по возрастанию
+/// @param[in]  keysList Список ключей. Результат записывается в него же
+/// @param[in]  count    Количество ключей
+/// @param[in]  depth    Индекс первого сравниваемого байта. Байты до depth у всех ключей совпадают
+static void jlsInsertionSortKeys(jlsSortKeyStruct *keysList, size_t count, size_t depth);
 
 /// @brief      Функция проверки строки на небезопасные символы
-/// @details    Выполняет посимвольную проверку stringPtr на наличие небезопасных символов
+/// @details    Данная функция выполняет пропуск безопасных ASCII символов при помощи jlsScanSafeAscii().
+///                 Символы не ASCII в кодировке UTF-8 декодируются jlsDecodeUtf8() и проверяются
+///                 jlsCheckIsPrintable(), в остальных кодировках остаток строки проверяется jlsCheckIsUnsafeMultibyte()
 /// @param[in]  stringPtr Указатель на строку
 /// @param[out] isOkPtr   Указатель на флаг успешного выполнения операции. Может быть равен 0
 /// @return     Возвращает true если в строке есть небезопасные символы.
 ///                 В противном случае, возвращает false
+/// @warning    Функция не потокобезопасна
 static bool jlsCheckIsUnsafe(const char *stringPtr, bool *isOkPtr);
 
+/// @brief      Функция посимвольной проверки строки на небезопасные символы при помощи mbrtowc()
+/// @details    Используется для кодировок, отличных от UTF-8
+/// @param[in]  stringPtr    Указатель на строку
+/// @param[in]  stringLength Длина строки
+/// @return     Возвращает true если в строке есть небезопасные символы.
+///                 В противном случае, возвращает false
+static bool jlsCheckIsUnsafeMultibyte(const char *stringPtr, size_t stringLength);
+
+/// @brief      Функция поиска первого байта, не являющегося безопасным ASCII символом
+/// @details    При наличии SSE2 данная функция проверяет по 16 байт за раз.
+///                 Остаток строки проверяется по jlsAsciiUnsafeBitmap
+/// @param[in]  stringPtr Указатель на строку
+/// @param[in]  length    Длина строки
+/// @return     Возвращает индекс найденного байта или length, если такого байта нет
+static size_t jlsScanSafeAscii(const char *stringPtr, size_t length);
+
+/// @brief      Функция декодирования символа UTF-8
+/// @details    Неполные и избыточно длинные последовательности, суррогаты и значения больше U+10FFFF
+///                 считаются некорректными
+/// @param[in]  stringPtr    Указатель на первый байт символа
+/// @param[in]  length       Количество доступных байт
+/// @param[out] codePointPtr Указатель на значение символа
+/// @return     Возвращает длину символа в байтах или 0, если последовательность некорректна
+static size_t jlsDecodeUtf8(const unsigned char *stringPtr, size_t length, uint32_t *codePointPtr);
+
+/// @brief      Функция проверки символа Unicode на печатаемость
+/// @details    Данная функция выполняет поиск в jlsPrintableBitmap. Блок из JLS_PRINTABLE_BLOCK_SIZE символов
+///                 заполняется при помощи iswprint() при первом обращении к нему
+/// @param[in]  codePoint Значение символа
+/// @return     Возвращает результат iswprint(codePoint)
+/// @warning    Функция не потокобезопасна
+static bool jlsCheckIsPrintable(uint32_t codePoint);
+
+/// @brief      Функция подготовки к выводу информации о файлах
+/// @details    Данная функция выполняет получение сброса цвета и обновление ширины окна, если включен цветной режим
+/// @param[out] isOkPtr Указатель на флаг успешного выполнения операции
+static void jlsPrintPrepare(bool *isOkPtr);
+
+/// @brief      Функция вывода строк информации о файлах из списка
+/// @details    Аналог jlsPrintFiles() без подготовки к выводу
+/// @param[in]  filesListPtr Указатель на список файлов
+/// @param[in]  alignmentPtr Указатель на структуру максимальных размеров полей информации о файле. Может быть равен 0
+/// @param[in]  safeType     Тип безопасного режима
+/// @param[out] isOkPtr      Указатель на флаг успешного выполнения операции
+static void jlsPrintFilesRows(const jlsFilesListStruct *filesListPtr, const jlsAlignmentStruct *alignmentPtr, jlsSafeTypesEnum safeType, bool *isOkPtr);
+
+/// @brief      Функция получения информации о файлах директории
+/// @details    Данная функция выполняет выбор способа получения информации о файлах по их количеству:
+///                 в нескольких потоках, пакетно через fileInfoGetBatchAt() или последовательно
+/// @param[in]  dirFd        Дескриптор директории
+/// @param[in]  namesList    Список имен файлов
+/// @param[out] fileInfoList Список указателей на информацию о файлах
+/// @param[in]  count        Количество файлов
+/// @param[out] isOkPtr      Указатель на флаг успешного выполнения операции
+static void jlsGetFilesInfo(int dirFd, const char *const *namesList, fileInfoStruct *const *fileInfoList, size_t count, bool *isOkPtr);
+
+/// @brief      Функция получения информации о файлах директории в нескольких потоках
+/// @details    Данная функция выполняет запуск threadsCount - 1 потоков jlsStatWorker(),
+///                 участвует в работе сама и дожидается завершения всех потоков
+/// @param[in]  dirFd        Дескриптор директории
+/// @param[in]  namesList    Список имен файлов
+/// @param[out] fileInfoList Список указателей на информацию о файлах
+/// @param[in]  count        Количество файлов
+/// @param[in]  threadsCount Количество потоков
+/// @param[out] isOkPtr      Указатель на флаг успешного выполнения операции
+static void jlsGetFilesInfoParallel(int dirFd, const char *const *namesList, fileInfoStruct *const *fileInfoList, size_t count, size_t threadsCount, bool *isOkPtr);
+
+/// @brief      Функция потока получения информации о файлах
+/// @details    Данная функция выполняет получение информации о файлах порциями по JLS_STAT_CHUNK_SIZE,
+///                 пока файлы не закончатся или не произойдет ошибка
+/// @param[in]  workPtr Указатель на jlsStatWorkStruct
+/// @return     Возвращает 0
+static void *jlsStatWorker(void *workPtr);
+
+/*
+    Внутренние макроподстановки
+*/
+
+/// @brief      Количество файлов, читаемых из директории за раз в jlsPrintDirTop()
+/// @details    Порция достаточно большая, чтобы информация о ней запрашивалась в нескольких потоках
+#define JLS_TOP_PORTION_SIZE 4096
+
+/// @brief      Начальный размер буфера преобразования имени файла в ключ сортировки
+#define JLS_SORT_KEY_BUFFER_SIZE_INITIAL 1024
+
+/// @brief      Количество ключей, начиная с которого jlsRadixSortKeys() распределяет ключи по корзинам
+#define JLS_RADIX_SORT_THRESHOLD 32
+
+/// @brief      Количество корзин jlsRadixSortKeys(): закончившиеся ключи и 256 значений байта
+#define JLS_RADIX_BUCKETS_COUNT 257
+
+// Корзина ключа KEY_PTR по байту DEPTH. Закончившиеся ключи меньше остальных и попадают в корзину 0
+#define JLS_RADIX_BUCKET(KEY_PTR, DEPTH) ((KEY_PTR)->keyLength > (DEPTH) ? (size_t)(unsigned char)(KEY_PTR)->keyPtr[DEPTH] + 1 : 0)
+
+/// @brief      Маркер числа в ключе естественного порядка. Меньше любого другого символа, кроме \0
+#define JLS_VERSION_KEY_MARKER 0x01
+
+/// @brief      Количество символов Unicode
+#define JLS_UNICODE_COUNT 0x110000
+
+/// @brief      Количество символов в блоке jlsPrintableBitmap, заполняемом за раз
+#define JLS_PRINTABLE_BLOCK_SIZE 256
+
+/// @brief      Битовая карта небезопасных ASCII символов от 0 до 63. См. jlsAsciiUnsafeBitmap
+#define JLS_ASCII_UNSAFE_BITMAP_LOW  0xD80007D7FFFFFFFFull
+
+/// @brief      Битовая карта небезопасных ASCII символов от 64 до 127. См. jlsAsciiUnsafeBitmap
+#define JLS_ASCII_UNSAFE_BITMAP_HIGH 0xB800000138000000ull
+
+// Флаги jlsQuoteClassesEnum байта C
+#define JLS_QUOTE_CLASS(C)          ((C) >= 0x80 ? jlsQuoteClassMultibyte : \
+                                     (((((C) < 64 ? JLS_ASCII_UNSAFE_BITMAP_LOW : JLS_ASCII_UNSAFE_BITMAP_HIGH) >> ((C) % 64)) & 1) ? jlsQuoteClassUnsafe : 0) | \
+                                     (((C) == '\'') ? jlsQuoteClassSingleQuote : 0) | \
+                                     (((C) == '"' || (C) == '$' || (C) == '`' || (C) == '\\') ? jlsQuoteClassDoubleSpecial : 0))
+#define JLS_QUOTE_CLASS4(C)         JLS_QUOTE_CLASS(C),      JLS_QUOTE_CLASS((C) + 1),  JLS_QUOTE_CLASS((C) + 2),  JLS_QUOTE_CLASS((C) + 3)
+#define JLS_QUOTE_CLASS16(C)        JLS_QUOTE_CLASS4(C),     JLS_QUOTE_CLASS4((C) + 4), JLS_QUOTE_CLASS4((C) + 8), JLS_QUOTE_CLASS4((C) + 12)
+#define JLS_QUOTE_CLASS64(C)        JLS_QUOTE_CLASS16(C),    JLS_QUOTE_CLASS16((C) + 16), JLS_QUOTE_CLASS16((C) + 32), JLS_QUOTE_CLASS16((C) + 48)
+
+#ifdef __SSE2__
+// Байты BLOCK из диапазона [FIRST; LAST]. Сравнение знаковое, поэтому байты не ASCII в диапазон не попадают
+#define JLS_SSE2_IN_RANGE(BLOCK, FIRST, LAST) _mm_and_si128(_mm_cmpgt_epi8((BLOCK), _mm_set1_epi8((FIRST) - 1)), \
+                                                            _mm_cmplt_epi8((BLOCK), _mm_set1_epi8((LAST) + 1)))
+#endif
+
 /*
     Внутренние переменные
 */
 
+/// @brief      Битовая карта небезопасных ASCII символов
+/// @details    Управляющие символы, пробел и символы, имеющие особое значение для командной оболочки.
+///                 Символ c соответствует биту (c % 64) элемента (c / 64)
+const uint64_t jlsAsciiUnsafeBitmap[2] = {JLS_ASCII_UNSAFE_BITMAP_LOW, JLS_ASCII_UNSAFE_BITMAP_HIGH};
+
+/// @brief      Таблица флагов jlsQuoteClassesEnum всех байтов
+/// @details    Строится препроцессором при сборке
+const uint8_t jlsQuoteClassesList[256] =
+{
+    JLS_QUOTE_CLASS64(0), JLS_QUOTE_CLASS64(64), JLS_QUOTE_CLASS64(128), JLS_QUOTE_CLASS64(192)
+};
+
+/// @brief      Названия полей сортировки в описании сортировки
+const char *const jlsSortFieldNamesList[jlsSortFieldCount] =
+{
+    [jlsSortFieldName]      = "name",
+    [jlsSortFieldTimeEdit]  = "mtime",
+    [jlsSortFieldSize]      = "size",
+    [jlsSortFieldExtension] = "extension",
+    [jlsSortFieldVersion]   = "version"
+};
+
+/// @brief      Длины последовательностей UTF-8 по 5 старшим битам первого байта. 0 - некорректный первый байт
+const uint8_t jlsUtf8LengthsList[32] =
+{
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    0, 0, 0, 0, 0, 0, 0, 0, 2, 2, 2, 2, 3, 3, 4, 0
+};
+
+/// @brief      Маски значащих битов первого байта UTF-8 по длине последовательности
+const uint8_t jlsUtf8MasksList[5] = {0, 0x7F, 0x1F, 0x0F, 0x07};
+
+/// @brief      Минимальные значения символов UTF-8 по длине последовательности
+const uint32_t jlsUtf8MinimumsList[5] = {0, 0, 0x80, 0x800, 0x10000};
+
+/// @brief      Битовая карта печатаемых символов Unicode
+/// @details    Символ c соответствует биту (c % 64) элемента (c / 64). Заполняется блоками в jlsCheckIsPrintable()
+uint64_t jlsPrintableBitmap[JLS_UNICODE_COUNT / 64] = {0};
+
+/// @brief      Флаги заполненных блоков jlsPrintableBitmap
+bool jlsPrintableBlocksList[JLS_UNICODE_COUNT / JLS_PRINTABLE_BLOCK_SIZE] = {0};
+
+/// @brief      Флаг проверки кодировки локали
+bool jlsIsCodesetChecked = false;
+
+/// @brief      Флаг кодировки локали UTF-8
+bool jlsIsCodesetUtf8 = false;
+
 /// @brief      Escape-последовательность для сброса цветов
-const char *jlsResetColorESC = "";
+const colorESCStruct *jlsResetColorPtr = 0;
+
+/// @brief      Флаг вывода jlsResetColorESC перед первым раскрашенным именем файла
+bool jlsIsResetPrinted = false;
 
 /// @brief      Отпуступы по умолчанию
 const jlsAlignmentStruct jlsAlignmentDefault = 
@@ -97,20 +522,42 @@ bool jlsIsSafeModeEnabled = false;
 
 bool jlsIsColorModeEnabled = false;
 
+size_t jlsDirBufferSize = DIR_READER_BUFFER_SIZE_DEFAULT;
+
+size_t jlsStatBatchThreshold = JLS_STAT_BATCH_THRESHOLD_DEFAULT;
+
+size_t jlsStatThreadsCount = 0;
+
+size_t jlsStatParallelThreshold = JLS_STAT_PARALLEL_THRESHOLD_DEFAULT;
+
+size_t jlsSortParallelThreshold = JLS_SORT_PARALLEL_THRESHOLD_DEFAULT;
+
+jlsSortSpecStruct jlsSortSpec =
+{
+    .fieldsList = {jlsSortFieldName},
+    .count      = 1
+};
+
+jlsSortEnum jlsSortOrder = jlsSortAscend;
+
+bool jlsIsStreamModeEnabled = false;
+
+size_t jlsStreamLookahead = JLS_STREAM_LOOKAHEAD_DEFAULT;
+
+size_t jlsTopCount = 0;
+
 /*
     Функции
 */
 
 int jls(const char *filePtr, const jlsAlignmentStruct *alignmentPtr, jlsSafeTypesEnum safeType)
 {
-    static char    fileInfoString[JLS_FILE_INFO_MAX_LENGTH] = {0};
-    static size_t  fileInfoStringLength = 0;
-
     bool isOk = true;
     
     // Объявление переменных, используемых в cleanup
-    fileInfoStruct      fileInfo   = {0};
-    jlsCommonInfoStruct commonInfo = {0};
+    fileInfoStruct      *fileInfoPtr = 0;
+    jlsFilesListStruct   filesList   = {0};
+    jlsCommonInfoStruct  commonInfo  = {0};
 
     if (!alignmentPtr)
     {
@@ -123,184 +570,296 @@ int jls(const char *filePtr, const jlsAlignmentStruct *alignmentPtr, jlsSafeType
         goto cleanup;
     }
 
-    if (jlsIsColorModeEnabled)
+    fileInfoPtr = calloc(1, sizeof(fileInfoStruct));
+    if (!fileInfoPtr)
     {
-        colorUpdateColorsList();
-        jlsResetColorESC = colorGetReset();
-        if (!jlsResetColorESC)
-        {
-            isOk = false;
-            goto cleanup;
-        }
-        jlsUpdateMaxVisibleChars();
+        isOk = false;
+        goto cleanup;
     }
 
-    fileInfoGet(filePtr, &fileInfo, true, &isOk);
+    fileInfoGet(filePtr, fileInfoPtr, true, &isOk);
     if (!isOk)
     {
+        free(fileInfoPtr);
+        fileInfoPtr = 0;
         goto cleanup;
     }
 
-    if (fileInfo.type != fileInfoTypeDirectory)
+    if (fileInfoPtr->type != fileInfoTypeDirectory)
     {
-        if (fileInfo.fileNamePtr)
+        if (fileInfoPtr->fileNamePtr)
         {
-            free(fileInfo.fileNamePtr);
-            fileInfo.fileNamePtr = 0;
+            free(fileInfoPtr->fileNamePtr);
+            fileInfoPtr->fileNamePtr = 0;
         }
         
-        fileInfo.fileNamePtr = malloc(strlen(filePtr) + 1);
-        if (!fileInfo.fileNamePtr)
+        fileInfoPtr->fileNamePtr = strdup(filePtr);
+        if (!fileInfoPtr->fileNamePtr)
         {
             isOk = false;
             goto cleanup;
         }
-        
-        strcpy(fileInfo.fileNamePtr, filePtr);
 
-        fileInfoStringLength = fileInfoToString(&fileInfo, &fileInfoString[0], JLS_FILE_INFO_MAX_LENGTH, &isOk);
-        if (isOk)
+        jlsFilesListAppend(&filesList, fileInfoPtr, &isOk);
+        if (!isOk)
         {
-            colorFileTargetStruct colors = {0};
-
-            if (jlsIsColorModeEnabled)
-            {
-                colors = colorFileToESC(&fileInfo, &isOk);
-                if (!isOk)
-                {
-                    goto cleanup;
-                }
-            }
-
-            jlsPrintFileInfo(&fileInfoString[0], alignmentPtr, safeType, &colors, &isOk);
             goto cleanup;
         }
+        fileInfoPtr = 0;
+
+        jlsPrintFiles(&filesList, alignmentPtr, safeType, &isOk);
         goto cleanup;
     }
     
+    if (jlsTopCount)
+    {
+        jlsPrintDirTop(filePtr, &isOk);
+        goto cleanup;
+    }
+
+    if (jlsIsStreamModeEnabled)
+    {
+        jlsPrintDirStream(filePtr, &isOk);
+        goto cleanup;
+    }
+
     commonInfo = jlsGetCommonInfo(filePtr, &isOk);
     if (!isOk || !commonInfo.files.count)
     {
-        printf("total 0\n");
+        outputWriteString("total 0");
+        outputNewLine();
         goto cleanup;
     }
 
     if (commonInfo.files.count >= 2)
     {
-        jlsSortFilesList(&commonInfo.files, jlsSortAscend, &isOk);
+        jlsSortFilesList(&commonInfo.files, &jlsSortSpec, jlsSortOrder, &isOk);
         if (!isOk)
         {
             goto cleanup;
         }
     }
 
-    char   fullPath[PATH_MAX] = {0};
-    size_t pathLength         = 0;
+    char totalString[sizeof("total 18446744073709551615")] = {0};
 
-    pathLength = jlsPathSet(filePtr, &fullPath[0], PATH_MAX, &isOk);
-    if (!isOk)
+    outputWrite(&totalString[0], (size_t)snprintf(&totalString[0], sizeof(totalString), "total %" PRIu64, commonInfo.total));
+    outputNewLine();
+
+    jlsPrintFiles(&commonInfo.files, &commonInfo.alignment, commonInfo.safeType, &isOk);
+
+cleanup:
+    if (fileInfoPtr)
+    {
+        fileInfoClear(fileInfoPtr);
+        free(fileInfoPtr);
+        fileInfoPtr = 0;
+    }
+
+    jlsFilesListClear(&filesList);
+    jlsFilesListClear(&commonInfo.files);
+
+    if (isOk)
+    {
+        return 0;
+    }
+    else
+    {
+        return 1;
+    }
+}
+
+void jlsPrintFiles(const jlsFilesListStruct *filesListPtr, const jlsAlignmentStruct *alignmentPtr, jlsSafeTypesEnum safeType, bool *isOkPtr)
+{
+    bool isOk = true;
+
+    if (!isOkPtr)
+    {
+        isOkPtr = &isOk;
+    }
+
+    *isOkPtr = true;
+
+    if (!filesListPtr || (filesListPtr->count && !filesListPtr->list))
+    {
+        *isOkPtr = false;
+        return;
+    }
+
+    jlsPrintPrepare(isOkPtr);
+    if (!*isOkPtr)
     {
+        return;
+    }
+
+    jlsPrintFilesRows(filesListPtr, alignmentPtr, safeType, isOkPtr);
+}
+
+void jlsPrintDirStream(const char *dirPtr, bool *isOkPtr)
+{
+    bool isOk = true;
+
+    if (!isOkPtr)
+    {
+        isOkPtr = &isOk;
+    }
+
+    *isOkPtr = true;
+
+    dirReaderEntryStruct directoryEntity = {0};
+    jlsAlignmentStruct   alignment       = {0};
+    bool                 isEnd           = false;
+    size_t               lookahead       = jlsStreamLookahead ? jlsStreamLookahead : 1;
+
+    // Объявление переменных, используемых в cleanup
+    dirReaderStruct      directory    = {0};
+    fileInfoStruct      *fileInfoList = 0;
+    arenaStruct          names        = {0};
+    const char         **namesList    = 0;
+    jlsFilesListStruct   filesList    = {0};
+
+    if (!dirPtr)
+    {
+        *isOkPtr = false;
+        goto cleanup;
+    }
+
+    jlsPrintPrepare(isOkPtr);
+    if (!*isOkPtr)
+    {
+        goto cleanup;
+    }
+
+    dirReaderOpen(&directory, dirPtr, jlsDirBufferSize, isOkPtr);
+    if (!*isOkPtr)
+    {
+        goto cleanup;
+    }
+
+    // Память выделяется один раз на порцию и переиспользуется
+    fileInfoList   = calloc(lookahead, sizeof(fileInfoStruct));
+    namesList      = calloc(lookahead, sizeof(const char *));
+    filesList.list = calloc(lookahead, sizeof(fileInfoStruct *));
+    if (!fileInfoList || !namesList || !filesList.list)
+    {
+        *isOkPtr = false;
         goto cleanup;
     }
 
-    printf("total %" PRIu64 "\n", commonInfo.total);
+    filesList.capacity = lookahead;
 
-    for (int i = 0; i < commonInfo.files.count; ++i)
+    for (size_t i = 0; i < lookahead; ++i)
     {
-        char *fileName = 0;
+        filesList.list[i] = &fileInfoList[i];
+    }
 
-        fileName = commonInfo.files.list[i];
+    while (!isEnd)
+    {
+        // Чтение очередной порции имен
+        filesList.count = 0;
+        arenaClear(&names);
 
-        if (fileInfo.fileNamePtr)
-        {
-            free(fileInfo.fileNamePtr);
-            fileInfo.fileNamePtr = 0;
-        }
-        if (fileInfo.targetInfo.filePathPtr)
+        while (filesList.count < lookahead)
         {
-            free(fileInfo.targetInfo.filePathPtr);
-            fileInfo.targetInfo.filePathPtr = 0;
+            if (!dirReaderNext(&directory, &directoryEntity, isOkPtr))
+            {
+                isEnd = true;
+                break;
+            }
+
+            if (directoryEntity.namePtr[0] == '.' &&
+                (directoryEntity.nameLength == 1 || (directoryEntity.nameLength == 2 && directoryEntity.namePtr[1] == '.')))
+            {
+                continue;
+            }
+
+            namesList[filesList.count] = arenaStringCopy(&names, directoryEntity.namePtr, directoryEntity.nameLength, isOkPtr);
+            if (!*isOkPtr)
+            {
+                goto cleanup;
+            }
+            ++filesList.count;
         }
-    
-        jlsPathAppend(fileName, &fullPath[0], pathLength, PATH_MAX, &isOk);
-        if (!isOk)
+        if (!*isOkPtr || !filesList.count)
         {
             goto cleanup;
         }
 
-        fileInfoGet(&fullPath[0], &fileInfo, true, &isOk);
-        if (!isOk)
+        jlsGetFilesInfo(directory.fd, namesList, filesList.list, filesList.count, isOkPtr);
+        if (!*isOkPtr)
         {
             goto cleanup;
         }
 
-        fileInfoStringLength = fileInfoToString(&fileInfo, &fileInfoString[0], JLS_FILE_INFO_MAX_LENGTH, &isOk);
-        if (!isOk)
+        for (size_t i = 0; i < filesList.count; ++i)
         {
-            goto cleanup;
+            jlsAlignmentUpdate(&alignment, filesList.list[i], isOkPtr);
+            if (!*isOkPtr)
+            {
+                goto cleanup;
+            }
         }
 
-        colorFileTargetStruct colors = {0};
+        jlsSafeTypesEnum safeType = jlsSafeTypeNone;
 
-        if (jlsIsColorModeEnabled)
+        if (jlsIsSafeModeEnabled)
         {
-            colors = colorFileToESC(&fileInfo, &isOk);
-            if (!isOk)
+            safeType = jlsCalculateSafeType(&filesList, isOkPtr);
+            if (!*isOkPtr)
             {
                 goto cleanup;
             }
         }
 
-        jlsPrintFileInfo(&fileInfoString[0], &commonInfo.alignment, commonInfo.safeType, &colors, &isOk);
-        if (!isOk)
+        jlsPrintFilesRows(&filesList, &alignment, safeType, isOkPtr);
+        if (!*isOkPtr)
+        {
+            goto cleanup;
+        }
+
+        // Порция выводится сразу, не дожидаясь заполнения буфера вывода
+        outputFlush(isOkPtr);
+        if (!*isOkPtr)
         {
             goto cleanup;
         }
+
+        for (size_t i = 0; i < filesList.count; ++i)
+        {
+            fileInfoClear(filesList.list[i]);
+        }
     }
 
 cleanup:
-    if (fileInfo.fileNamePtr)
-    {
-        free(fileInfo.fileNamePtr);
-        fileInfo.fileNamePtr = 0;
-    }
-    if (fileInfo.targetInfo.filePathPtr)
-    {
-        free(fileInfo.targetInfo.filePathPtr);
-        fileInfo.targetInfo.filePathPtr = 0;
-    }
+    dirReaderClose(&directory);
 
-    if (commonInfo.files.list)
+    if (fileInfoList)
     {
-        for (int i = 0; i < commonInfo.files.count; ++i)
+        for (size_t i = 0; i < filesList.count; ++i)
         {
-            if (commonInfo.files.list[i])
-            {
-                free(commonInfo.files.list[i]);
-                commonInfo.files.list[i] = 0;
-            }
+            fileInfoClear(&fileInfoList[i]);
         }
-    }
-    if (commonInfo.files.list)
-    {
-        free(commonInfo.files.list);
-        commonInfo.files.list = 0;
+
+        free(fileInfoList);
+        fileInfoList = 0;
     }
 
-    if (isOk)
+    if (namesList)
     {
-        return 0;
+        free(namesList);
+        namesList = 0;
     }
-    else
+
+    if (filesList.list)
     {
-        return 1;
+        free(filesList.list);
+        filesList.list = 0;
     }
+
+    arenaClear(&names);
 }
 
-void jlsPrintFileInfo(const char *fileInfoStringPtr, const jlsAlignmentStruct *alignmentPtr, jlsSafeTypesEnum safeType, const colorFileTargetStruct *colorsPtr, bool *isOkPtr)
+void jlsPrintFileInfo(const fileInfoColumnsStruct *columnsPtr, const jlsAlignmentStruct *alignmentPtr, jlsSafeTypesEnum safeType, const colorFileTargetStruct *colorsPtr, bool *isOkPtr)
 {
-    static const char delimer[] = {FILE_INFO_TO_STRING_DELIMER, '\0'};
-    
     bool isOk = true;
 
     if (!isOkPtr)
@@ -309,10 +868,8 @@ void jlsPrintFileInfo(const char *fileInfoStringPtr, const jlsAlignmentStruct *a
     }
 
     *isOkPtr = true;
-    
-    char buffer[JLS_FILE_INFO_MAX_LENGTH] = {0};
 
-    if (!fileInfoStringPtr)
+    if (!columnsPtr)
     {
         *isOkPtr = false;
         return;
@@ -326,47 +883,38 @@ void jlsPrintFileInfo(const char *fileInfoStringPtr, const jlsAlignmentStruct *a
     }
 
     colorFileTargetStruct colors = {0};
-    static bool isResetPrinted = false;
 
     if (!jlsIsColorModeEnabled || !colorsPtr)
     {
         colorsPtr = &colors;
     }
 
-    memcpy(&buffer[0], &fileInfoStringPtr[0], strlen(fileInfoStringPtr) < JLS_FILE_INFO_MAX_LENGTH - 1 ? 
-                                              strlen(fileInfoStringPtr) : JLS_FILE_INFO_MAX_LENGTH - 1);
-
-    char *fileInfoStringTypePtr       = 0;
-    char *fileInfoStringAccessPtr     = 0;
-    char *fileInfoStringLinksCountPtr = 0;
-    char *fileInfoStringOwnerPtr      = 0;
-    char *fileInfoStringGroupPtr      = 0;
-    char *fileInfoStringSizePtr       = 0;
-    char *fileInfoStringTimeEditPtr   = 0;
-    char *fileInfoStringFilePtr       = 0;
-    char *fileInfoStringTargetPtr     = 0;
-
-    fileInfoStringTypePtr       = strtok(&buffer[0], delimer);
-    fileInfoStringAccessPtr     = strtok(NULL,       delimer);
-    fileInfoStringLinksCountPtr = strtok(NULL,       delimer);
-    fileInfoStringOwnerPtr      = strtok(NULL,       delimer);
-    fileInfoStringGroupPtr      = strtok(NULL,       delimer);
-    fileInfoStringSizePtr       = strtok(NULL,       delimer);
-    fileInfoStringTimeEditPtr   = strtok(NULL,       delimer);
-    fileInfoStringFilePtr       = strtok(NULL,       delimer);
-    fileInfoStringTargetPtr     = strtok(NULL,       delimer);
+    const char *const *fieldsList     = &columnsPtr->fieldsList[0];
+    const char        *fileNamePtr    = fieldsList[fileInfoColumnFileName];
+    size_t             fileNameLength = columnsPtr->lengthsList[fileInfoColumnFileName];
+    const char        *targetPtr      = fieldsList[fileInfoColumnTarget];
+    size_t             targetLength   = columnsPtr->lengthsList[fileInfoColumnTarget];
 
     // Информация для вывода \033[K
     size_t visibleCharsCount   = 0;
     size_t nameStartCharNumber = 0;
 
-    nameStartCharNumber = printf("%s%s %*s %-*s %-*s %*s %s ", fileInfoStringTypePtr,
-                                                               fileInfoStringAccessPtr,
-                                (int)alignmentPtr->linksCount, fileInfoStringLinksCountPtr,
-                                (int)alignmentPtr->owner,      fileInfoStringOwnerPtr,
-                                (int)alignmentPtr->group,      fileInfoStringGroupPtr,
-                                (int)alignmentPtr->size,       fileInfoStringSizePtr,
-                                                               fileInfoStringTimeEditPtr);
+    const size_t *lengthsList = &columnsPtr->lengthsList[0];
+
+    // Аналог printf("%s%s %*s %-*s %-*s %*s %s ")
+    nameStartCharNumber += outputWrite(fieldsList[fileInfoColumnType],   lengthsList[fileInfoColumnType]);
+    nameStartCharNumber += outputWrite(fieldsList[fileInfoColumnAccess], lengthsList[fileInfoColumnAccess]);
+    nameStartCharNumber += outputWriteChar(' ');
+    nameStartCharNumber += outputWritePadded(fieldsList[fileInfoColumnLinksCount], lengthsList[fileInfoColumnLinksCount], alignmentPtr->linksCount, false);
+    nameStartCharNumber += outputWriteChar(' ');
+    nameStartCharNumber += outputWritePadded(fieldsList[fileInfoColumnOwner],      lengthsList[fileInfoColumnOwner],      alignmentPtr->owner,      true);
+    nameStartCharNumber += outputWriteChar(' ');
+    nameStartCharNumber += outputWritePadded(fieldsList[fileInfoColumnGroup],      lengthsList[fileInfoColumnGroup],      alignmentPtr->group,      true);
+    nameStartCharNumber += outputWriteChar(' ');
+    nameStartCharNumber += outputWritePadded(fieldsList[fileInfoColumnSize],       lengthsList[fileInfoColumnSize],       alignmentPtr->size,       false);
+    nameStartCharNumber += outputWriteChar(' ');
+    nameStartCharNumber += outputWrite(fieldsList[fileInfoColumnTimeEdit], lengthsList[fileInfoColumnTimeEdit]);
+    nameStartCharNumber += outputWriteChar(' ');
 
     if (!jlsIsSafeModeEnabled)
     {
@@ -380,51 +928,52 @@ void jlsPrintFileInfo(const char *fileInfoStringPtr, const jlsAlignmentStruct *a
         size_t before = 0;
         size_t after  = 0;
 
-        before = strlen(fileInfoStringFilePtr) + 1;
+        before = fileNameLength;
 
-        after = jlsMakeStringSafe(fileInfoStringFilePtr, &safeStringFile[0], FILE_INFO_TARGET_LENGTH_MAX, isOkPtr);
+        after = jlsMakeStringSafe(fileNamePtr, &safeStringFile[0], FILE_INFO_TARGET_LENGTH_MAX, isOkPtr);
         if (!*isOkPtr)
         {
             *isOkPtr = false;
             return;
         }
 
+        // Имя без экранирования выравнивается с экранированными
         if (before == after)
         {
-            printf(" ");
-            ++nameStartCharNumber;
+            nameStartCharNumber += outputWriteChar(' ');
         }
 
-        fileInfoStringFilePtr = &safeStringFile[0];
+        fileNamePtr    = &safeStringFile[0];
+        fileNameLength = after;
     }
 
     if (!jlsIsColorModeEnabled)
     {
-        printf("%s", fileInfoStringFilePtr);
+        outputWrite(fileNamePtr, fileNameLength);
     }
     else
     {
         bool isColored = false;
 
-        if (strcmp(&colorsPtr->file[0], jlsResetColorESC) != 0)
+        if (colorsPtr->filePtr && !colorsPtr->filePtr->isReset)
         {
-            if (!isResetPrinted)
+            if (!jlsIsResetPrinted)
             {
-                printf("%s", jlsResetColorESC);
-                isResetPrinted = true;
+                outputWrite(jlsResetColorPtr->stringPtr, jlsResetColorPtr->length);
+                jlsIsResetPrinted = true;
             }
-            printf("%s", &colorsPtr->file[0]);
+            outputWrite(colorsPtr->filePtr->stringPtr, colorsPtr->filePtr->length);
             isColored  = true;
         }
 
-        visibleCharsCount = printf("%s", fileInfoStringFilePtr);
+        visibleCharsCount = outputWrite(fileNamePtr, fileNameLength);
         
         if (isColored)
         {
-            printf("%s", jlsResetColorESC);
+            outputWrite(jlsResetColorPtr->stringPtr, jlsResetColorPtr->length);
             if (nameStartCharNumber / jlsMaxVisibleChars != (nameStartCharNumber + visibleCharsCount - 1) / jlsMaxVisibleChars)
             {
-                printf("\033[K");
+                outputWriteString("\033[K");
             }
         }
         
@@ -433,50 +982,50 @@ void jlsPrintFileInfo(const char *fileInfoStringPtr, const jlsAlignmentStruct *a
 
     char safeStringTarget[FILE_INFO_TARGET_LENGTH_MAX] = {0};
 
-    if (fileInfoStringTargetPtr)
+    if (targetPtr)
     {
         if (safeType & jlsSafeTypeTarget)
         {
-            jlsMakeStringSafe(fileInfoStringTargetPtr, &safeStringTarget[0], FILE_INFO_TARGET_LENGTH_MAX, isOkPtr);
+            targetLength = jlsMakeStringSafe(targetPtr, &safeStringTarget[0], FILE_INFO_TARGET_LENGTH_MAX, isOkPtr);
             if (!*isOkPtr)
             {
                 *isOkPtr = false;
                 return;
             }
 
-            fileInfoStringTargetPtr = &safeStringTarget[0];
+            targetPtr = &safeStringTarget[0];
         }
 
-        visibleCharsCount    = printf(" -> ");
+        visibleCharsCount    = outputWriteString(" -> ");
         nameStartCharNumber += visibleCharsCount;
 
         if (!jlsIsColorModeEnabled)
         {
-            printf("%s", fileInfoStringTargetPtr);
+            outputWrite(targetPtr, targetLength);
         }
         else
         {
             bool isColored = false;
 
-            if (strcmp(&colorsPtr->target[0], jlsResetColorESC) != 0)
+            if (colorsPtr->targetPtr && !colorsPtr->targetPtr->isReset)
             {
-                if (!isResetPrinted)
+                if (!jlsIsResetPrinted)
                 {
-                    printf("%s", jlsResetColorESC);
-                    isResetPrinted = true;
+                    outputWrite(jlsResetColorPtr->stringPtr, jlsResetColorPtr->length);
+                    jlsIsResetPrinted = true;
                 }
-                printf("%s", &colorsPtr->target[0]);
+                outputWrite(colorsPtr->targetPtr->stringPtr, colorsPtr->targetPtr->length);
                 isColored  = true;
             }
 
-            visibleCharsCount = printf("%s", fileInfoStringTargetPtr);
+            visibleCharsCount = outputWrite(targetPtr, targetLength);
             
             if (isColored)
             {
-                printf("%s", jlsResetColorESC);
+                outputWrite(jlsResetColorPtr->stringPtr, jlsResetColorPtr->length);
                 if (nameStartCharNumber / jlsMaxVisibleChars != (nameStartCharNumber + visibleCharsCount - 1) / jlsMaxVisibleChars)
                 {
-                    printf("\033[K");
+                    outputWriteString("\033[K");
                 }
             }
             
@@ -484,10 +1033,10 @@ void jlsPrintFileInfo(const char *fileInfoStringPtr, const jlsAlignmentStruct *a
         }
     }
 
-    printf("\n");
+    outputNewLine();
 }
 
-jlsCommonInfoStruct jlsGetCommonInfo(const char *dirPtr, bool *isOkPtr)
+void jlsPrintDirTop(const char *dirPtr, bool *isOkPtr)
 {
     bool isOk = true;
 
@@ -498,396 +1047,359 @@ jlsCommonInfoStruct jlsGetCommonInfo(const char *dirPtr, bool *isOkPtr)
 
     *isOkPtr = true;
 
-    struct dirent *directoryEntity   = {0};
-    size_t         currentFileNumber = 0;
+    dirReaderEntryStruct directoryEntity = {0};
+    jlsAlignmentStruct   alignment       = {0};
+    jlsSafeTypesEnum     safeType        = jlsSafeTypeNone;
+    bool                 isByteCollation = jlsCheckIsByteCollation();
+    bool                 isDescend       = jlsSortOrder == jlsSortDescend && jlsSortSpec.count;
+    bool                 isStatNeeded    = false;
+    bool                 isEnd           = false;
+    size_t               entriesCount    = 0;
+    size_t               entriesCapacity = 0;
+    size_t               filesCount      = 0;
 
     // Объявление переменных, используемых в cleanup
-    DIR                 *directory = 0;
-    jlsCommonInfoStruct  answer    = {0};
-    fileInfoStruct       fileInfo  = {0};
-
-    if (!dirPtr)
+    dirReaderStruct         directory    = {0};
+    jlsTopEntryStruct      *entriesList  = 0;
+    size_t                 *heapList     = 0;
+    fileInfoStruct         *fileInfoList = 0;
+    fileInfoStruct        **portionList  = 0;
+    size_t                  portionCount = 0;
+    arenaStruct             names        = {0};
+    const char            **namesList    = 0;
+    jlsSortKeyBufferStruct  key          = {0};
+    jlsFilesListStruct      filesList    = {0};
+    fileInfoStruct         *fileInfoPtr  = 0;
+
+    if (!dirPtr || !jlsTopCount)
     {
         *isOkPtr = false;
         goto cleanup;
     }
 
-    answer.files.count = jlsCountFilesInDirectory(dirPtr, isOkPtr);
-    if (!answer.files.count || !*isOkPtr)
+    // Информация о каждом файле запрашивается, только если от нее зависит порядок
+    for (size_t field = 0; field < jlsSortSpec.count; ++field)
     {
-        goto cleanup;
+        if (jlsSortSpec.fieldsList[field] == jlsSortFieldTimeEdit || jlsSortSpec.fieldsList[field] == jlsSortFieldSize)
+        {
+            isStatNeeded = true;
+        }
     }
 
-    answer.files.list = calloc(answer.files.count, sizeof(answer.files.list));
-    if (!answer.files.list)
+    dirReaderOpen(&directory, dirPtr, jlsDirBufferSize, isOkPtr);
+    if (!*isOkPtr)
     {
-        *isOkPtr = false;
         goto cleanup;
     }
 
-    directory = opendir(dirPtr);
-    if (!directory)
+    fileInfoList = calloc(JLS_TOP_PORTION_SIZE, sizeof(fileInfoStruct));
+    portionList  = calloc(JLS_TOP_PORTION_SIZE, sizeof(fileInfoStruct *));
+    namesList    = calloc(JLS_TOP_PORTION_SIZE, sizeof(const char *));
+    if (!fileInfoList || !portionList || !namesList)
     {
         *isOkPtr = false;
         goto cleanup;
     }
 
-    char   fullPath[PATH_MAX] = {0};
-    size_t pathLength         = 0;
-
-    pathLength = jlsPathSet(dirPtr, &fullPath[0], PATH_MAX, isOkPtr);
-    if (!*isOkPtr)
+    for (size_t i = 0; i < JLS_TOP_PORTION_SIZE; ++i)
     {
-        goto cleanup;
+        portionList[i] = &fileInfoList[i];
     }
 
-    while ((directoryEntity = readdir(directory)) != NULL) 
+    while (!isEnd)
     {
-        /*
-            Общее. Начало цикла
-        */
+        // Чтение очередной порции имен
+        portionCount = 0;
+        arenaClear(&names);
 
-        jlsPathAppend(directoryEntity->d_name, &fullPath[0], pathLength, PATH_MAX, isOkPtr);
-        if (!*isOkPtr)
+        while (portionCount < JLS_TOP_PORTION_SIZE)
         {
-            goto cleanup;
-        }
+            if (!dirReaderNext(&directory, &directoryEntity, isOkPtr))
+            {
+                isEnd = true;
+                break;
+            }
 
-        /*
-            Расчет answer.files
-        */
+            if (directoryEntity.namePtr[0] == '.' &&
+                (directoryEntity.nameLength == 1 || (directoryEntity.nameLength == 2 && directoryEntity.namePtr[1] == '.')))
+            {
+                continue;
+            }
 
-        if (strcmp(directoryEntity->d_name, ".")  == 0 ||
-            strcmp(directoryEntity->d_name, "..") == 0)
-        {
-            continue;
+            namesList[portionCount] = arenaStringCopy(&names, directoryEntity.namePtr, directoryEntity.nameLength, isOkPtr);
+            if (!*isOkPtr)
+            {
+                goto cleanup;
+            }
+            ++portionCount;
         }
-
-        answer.files.list[currentFileNumber] = malloc(strlen(directoryEntity->d_name) + 1);
-        if (!answer.files.list[currentFileNumber])
+        if (!*isOkPtr)
         {
-            *isOkPtr = false;
             goto cleanup;
         }
 
-        strcpy(answer.files.list[currentFileNumber], directoryEntity->d_name);
-
-        /*
-            Общее. Получение информации о файле
-        */
-
-        static char fileInfoString[JLS_FILE_INFO_MAX_LENGTH] = {0};
-
-        if (fileInfo.fileNamePtr)
-        {
-            free(fileInfo.fileNamePtr);
-            fileInfo.fileNamePtr = 0;
-        }
-        if (fileInfo.targetInfo.filePathPtr)
+        if (isStatNeeded)
         {
-            free(fileInfo.targetInfo.filePathPtr);
-            fileInfo.targetInfo.filePathPtr = 0;
+            jlsGetFilesInfo(directory.fd, namesList, portionList, portionCount, isOkPtr);
+            if (!*isOkPtr)
+            {
+                goto cleanup;
+            }
         }
 
-        fileInfoGet(&fullPath[0], &fileInfo, false, isOkPtr);
-        if (!*isOkPtr)
+        for (size_t i = 0; i < portionCount; ++i, ++filesCount)
         {
-            goto cleanup;
-        }
-
-        fileInfoToString(&fileInfo, &fileInfoString[0], JLS_FILE_INFO_MAX_LENGTH, isOkPtr);
-        if (!*isOkPtr)
-        {
-            goto cleanup;
-        }
-
-        /*
-            Расчет answer.alignment
-        */
+            fileInfoStruct nameInfo = {.fileNamePtr = (char *)namesList[i]};
 
-        static const char  delimer[] = {FILE_INFO_TO_STRING_DELIMER, '\0'};
-        static       char *field     = 0;
-
-        // Пропускаем тип файла
-        field = strtok(&fileInfoString[0], delimer);
-        // Пропускаем права доступа файла
-        field = strtok(NULL, delimer);
+            // Без сортировки файлы упорядочиваются по номеру в директории, как и в jlsSortFilesList(), без учета jlsSortOrder
+            if (jlsSortSpec.count)
+            {
+                jlsSortKeyBuild(&key, isStatNeeded ? portionList[i] : &nameInfo, &jlsSortSpec, isByteCollation, isOkPtr);
+            }
+            else
+            {
+                key.length = 0;
+                jlsSortKeyAppendNumber(&key, filesCount, false, isOkPtr);
+            }
+            if (!*isOkPtr)
+            {
+                goto cleanup;
+            }
 
-        field = strtok(NULL, delimer);
-        if (answer.alignment.linksCount < strlen(field))
-        {
-            answer.alignment.linksCount = strlen(field);
-        }
+            bool   isFull = entriesCount == jlsTopCount;
+            size_t index  = entriesCount;
 
-        field = strtok(NULL, delimer);
-        if (answer.alignment.owner < strlen(field))
-        {
-            answer.alignment.owner = strlen(field);
-        }
+            if (isFull)
+            {
+                // Файл вытесняет последний из отобранных, только если выводится раньше него
+                index = heapList[0];
+                if (jlsTopKeysCompare(&key, &entriesList[index].key, isDescend) >= 0)
+                {
+                    continue;
+                }
 
-        field = strtok(NULL, delimer);
-        if (answer.alignment.group < strlen(field))
-        {
-            answer.alignment.group = strlen(field);
-        }
+                fileInfoClear(&entriesList[index].fileInfo);
+            }
+            else
+            {
+                // Память растет вместе с количеством отобранных файлов, а не с jlsTopCount
+                if (entriesCount == entriesCapacity)
+                {
+                    size_t newCapacity = entriesCapacity ? entriesCapacity * 2 : JLS_FILES_LIST_CAPACITY_INITIAL;
+
+                    if (newCapacity > jlsTopCount)
+                    {
+                        newCapacity = jlsTopCount;
+                    }
+
+                    jlsTopEntryStruct *newEntriesList = realloc(entriesList, newCapacity * sizeof(jlsTopEntryStruct));
+                    size_t            *newHeapList    = realloc(heapList, newCapacity * sizeof(size_t));
+                    if (newEntriesList)
+                    {
+                        entriesList = newEntriesList;
+                    }
+                    if (newHeapList)
+                    {
+                        heapList = newHeapList;
+                    }
+                    if (!newEntriesList || !newHeapList)
+                    {
+                        *isOkPtr = false;
+                        goto cleanup;
+                    }
+
+                    memset(&entriesList[entriesCapacity], 0, (newCapacity - entriesCapacity) * sizeof(jlsTopEntryStruct));
+                    entriesCapacity = newCapacity;
+                }
 
-        field = strtok(NULL, delimer);
-        if (answer.alignment.size < strlen(field))
-        {
-            answer.alignment.size = strlen(field);
-        }
+                heapList[entriesCount++] = index;
+            }
 
-        /*
-            Расчет answer.safeType
-        */
+            // Буферы ключей меняются местами, чтобы не копировать ключ
+            jlsSortKeyBufferStruct entryKey = entriesList[index].key;
 
-        if (jlsIsSafeModeEnabled)
-        {
-            static bool isFileUnsafe   = false;
-            static bool isTargetUnsafe = false;
+            entriesList[index].key = key;
+            key                    = entryKey;
 
-            if (!isFileUnsafe)
+            if (isStatNeeded)
+            {
+                entriesList[index].fileInfo = *portionList[i];
+                memset(portionList[i], 0, sizeof(fileInfoStruct));
+            }
+            else
             {
-                isFileUnsafe = jlsCheckIsUnsafe(fileInfo.fileNamePtr, isOkPtr);
-                if (!*isOkPtr)
+                entriesList[index].fileInfo.fileNamePtr = strdup(namesList[i]);
+                if (!entriesList[index].fileInfo.fileNamePtr)
                 {
+                    *isOkPtr = false;
                     goto cleanup;
                 }
             }
 
-            if (!isTargetUnsafe && fileInfo.type == fileInfoTypeLink)
+            if (isFull)
             {
-                isTargetUnsafe = jlsCheckIsUnsafe(fileInfo.targetInfo.fileNamePtr, isOkPtr);
-                if (!*isOkPtr)
-                {
-                    goto cleanup;
-                }
+                jlsTopHeapSiftDown(entriesList, heapList, entriesCount, 0, isDescend);
             }
-        
-            if (currentFileNumber + 1 == answer.files.count)
+            else if (entriesCount == jlsTopCount)
             {
-                if (isFileUnsafe)
-                {
-                    answer.safeType += jlsSafeTypeName;
-                }
-                if (isTargetUnsafe)
+                for (size_t start = entriesCount / 2; start-- > 0;)
                 {
-                    answer.safeType += jlsSafeTypeTarget;
+                    jlsTopHeapSiftDown(entriesList, heapList, entriesCount, start, isDescend);
                 }
             }
         }
 
-        /*
-            Расчет answer.blocks
-        */
-
-        answer.total += fileInfo.blocks;
-        if (!*isOkPtr)
-        {
-            goto cleanup;
-        }
-    
-        if (currentFileNumber + 1 == answer.files.count)
+        for (size_t i = 0; i < portionCount && isStatNeeded; ++i)
         {
-            answer.total /= 2;
+            fileInfoClear(portionList[i]);
         }
+        portionCount = 0;
+    }
 
-        /*
-            Общее. Завершение цикла
-        */
-
-        ++currentFileNumber;
-        if (currentFileNumber == answer.files.count)
+    if (entriesCount < jlsTopCount)
+    {
+        for (size_t start = entriesCount / 2; start-- > 0;)
         {
-            // Если количество файлов в директории изменилось за время выполнения функции, обрабатываем не все файлы
-            break;
+            jlsTopHeapSiftDown(entriesList, heapList, entriesCount, start, isDescend);
         }
     }
 
-cleanup:
-    if (directory)
+    // Пирамидальная сортировка: последний из отобранных файлов переносится в конец
+    for (size_t count = entriesCount; count > 1; --count)
     {
-        closedir(directory);
-    }
+        size_t index = heapList[0];
 
-    if (fileInfo.fileNamePtr)
-    {
-        free(fileInfo.fileNamePtr);
-        fileInfo.fileNamePtr = 0;
-    }
-    if (fileInfo.targetInfo.filePathPtr)
-    {
-        free(fileInfo.targetInfo.filePathPtr);
-        fileInfo.targetInfo.filePathPtr = 0;
+        heapList[0]         = heapList[count - 1];
+        heapList[count - 1] = index;
+
+        jlsTopHeapSiftDown(entriesList, heapList, count - 1, 0, isDescend);
     }
 
-    if (!*isOkPtr)
+    for (size_t i = 0; i < entriesCount; ++i)
     {
-        if (answer.files.list)
+        fileInfoPtr = calloc(1, sizeof(fileInfoStruct));
+        if (!fileInfoPtr)
         {
-            for (int i = 0; i < answer.files.count; ++i)
-            {
-                if (answer.files.list[i])
-                {
-                    free(answer.files.list[i]);
-                    answer.files.list[i] = 0;
-                }
-            }
+            *isOkPtr = false;
+            goto cleanup;
         }
-        if (answer.files.list)
+
+        jlsFilesListAppend(&filesList, fileInfoPtr, isOkPtr);
+        if (!*isOkPtr)
         {
-            free(answer.files.list);
-            answer.files.list = 0;
+            goto cleanup;
         }
-    }
-    
-    if (*isOkPtr)
-    {
-        return answer;
-    }
-    else
-    {
-        return (jlsCommonInfoStruct){0};
-    }
-}
+        fileInfoPtr = 0;
 
-jlsFilesListStruct jlsGetFilesList(const char *dirPtr, bool *isOkPtr)
-{
-    bool isOk = true;
+        if (isStatNeeded)
+        {
+            *filesList.list[i] = entriesList[heapList[i]].fileInfo;
+            memset(&entriesList[heapList[i]].fileInfo, 0, sizeof(fileInfoStruct));
+        }
+    }
 
-    if (!isOkPtr)
+    // Информация запрашивается только об отобранных файлах
+    if (!isStatNeeded && entriesCount)
     {
-        isOkPtr = &isOk;
-    }
+        const char **newNamesList = realloc(namesList, entriesCount * sizeof(const char *));
+        if (!newNamesList)
+        {
+            *isOkPtr = false;
+            goto cleanup;
+        }
+        namesList = newNamesList;
 
-    *isOkPtr = true;
-    
-    size_t         filesCount      = 0;
-    struct dirent *directoryEntity = {0};
-    
-    // Объявление переменных, используемых в cleanup
-    jlsFilesListStruct answer          = {0};
-    DIR               *directory       = 0;
+        for (size_t i = 0; i < entriesCount; ++i)
+        {
+            namesList[i] = entriesList[heapList[i]].fileInfo.fileNamePtr;
+        }
 
-    filesCount = jlsCountFilesInDirectory(dirPtr, isOkPtr);
-    if (!filesCount || !*isOkPtr)
-    {
-        goto cleanup;
+        jlsGetFilesInfo(directory.fd, namesList, filesList.list, filesList.count, isOkPtr);
+        if (!*isOkPtr)
+        {
+            goto cleanup;
+        }
     }
 
-    answer.list = calloc(filesCount, sizeof(char *));
-    if (!answer.list)
+    if (!filesList.count)
     {
-        *isOkPtr = false;
         goto cleanup;
     }
 
-    directory = opendir(dirPtr);
-    if (!directory)
+    // Ширина полей рассчитывается только по выводимым файлам
+    alignment = jlsCalculateAlignment(&filesList, isOkPtr);
+    if (!*isOkPtr)
     {
-        *isOkPtr = false;
         goto cleanup;
     }
 
-    while ((directoryEntity = readdir(directory)) != NULL) 
+    if (jlsIsSafeModeEnabled)
     {
-        if (strcmp(directoryEntity->d_name, ".")  == 0 ||
-            strcmp(directoryEntity->d_name, "..") == 0)
-        {
-            continue;
-        }
-
-        answer.list[answer.count] = malloc(strlen(directoryEntity->d_name) + 1);
-        if (!answer.list[answer.count])
+        safeType = jlsCalculateSafeType(&filesList, isOkPtr);
+        if (!*isOkPtr)
         {
-            *isOkPtr = false;
             goto cleanup;
         }
+    }
 
-        strcpy(answer.list[answer.count], directoryEntity->d_name);
+    jlsPrintFiles(&filesList, &alignment, safeType, isOkPtr);
 
-        ++answer.count;
-        if (answer.count == filesCount)
+cleanup:
+    dirReaderClose(&directory);
+
+    if (entriesList)
+    {
+        for (size_t i = 0; i < entriesCapacity; ++i)
         {
-            // Если количество файлов в директории изменилось за время выполнения функции, обрабатываем не все файлы
-            break;
+            fileInfoClear(&entriesList[i].fileInfo);
+            free(entriesList[i].key.dataPtr);
         }
+
+        free(entriesList);
+        entriesList = 0;
     }
 
-cleanup:
-    if (directory)
+    if (heapList)
     {
-        closedir(directory);
+        free(heapList);
+        heapList = 0;
     }
 
-    if (!*isOkPtr)
+    if (fileInfoList)
     {
-        if (answer.list)
-        {
-            for (int i = 0; i < answer.count; ++i)
-            {
-                if (answer.list[i])
-                {
-                    free(answer.list[i]);
-                    answer.list[i] = 0;
-                }
-            }
-        }
-        if (answer.list)
+        for (size_t i = 0; i < portionCount && isStatNeeded; ++i)
         {
-            free(answer.list);
-            answer.list = 0;
+            fileInfoClear(&fileInfoList[i]);
         }
-    }
 
-    if (*isOkPtr)
-    {
-        return answer;
-    }
-    else
-    {
-        return (jlsFilesListStruct){0};
+        free(fileInfoList);
+        fileInfoList = 0;
     }
-}
 
-void jlsSortFilesList(jlsFilesListStruct *filesListPtr, jlsSortEnum sort, bool *isOkPtr)
-{
-    bool isOk = true;
-
-    if (!isOkPtr)
+    if (portionList)
     {
-        isOkPtr = &isOk;
+        free(portionList);
+        portionList = 0;
     }
 
-    *isOkPtr = true;
-    
-    if (!filesListPtr || !filesListPtr->list || filesListPtr->count < 2)
+    if (namesList)
     {
-        *isOkPtr = false;
-        return;
+        free(namesList);
+        namesList = 0;
     }
 
-    switch (sort)
+    if (fileInfoPtr)
     {
-        case jlsSortNone:
-        default:
-            break;
-
-        case jlsSortAscend:
-        {
-            qsort(filesListPtr->list, filesListPtr->count, sizeof(char *), jlsFilesListCompareAscend);
-            break;
-        }
-
-        case jlsSortDescend:
-        {
-            qsort(filesListPtr->list, filesListPtr->count, sizeof(char *), jlsFilesListCompareDescend);
-            break;
-        }
+        free(fileInfoPtr);
+        fileInfoPtr = 0;
     }
+
+    free(key.dataPtr);
+    arenaClear(&names);
+    jlsFilesListClear(&filesList);
 }
 
-size_t jlsCountFilesInDirectory(const char *dirPtr, bool *isOkPtr)
+jlsCommonInfoStruct jlsGetCommonInfo(const char *dirPtr, bool *isOkPtr)
 {
     bool isOk = true;
 
@@ -897,37 +1409,47 @@ size_t jlsCountFilesInDirectory(const char *dirPtr, bool *isOkPtr)
     }
 
     *isOkPtr = true;
-    
-    size_t         answer          = 0;
-    DIR           *directory       = 0;
-    struct dirent *directoryEntity = {0};
 
-    directory = opendir(dirPtr);
-    if (!directory)
+    // Объявление переменных, используемых в cleanup
+    jlsCommonInfoStruct answer = {0};
+
+    answer.files = jlsGetFilesList(dirPtr, isOkPtr);
+    if (!*isOkPtr)
     {
-        *isOkPtr = false;
-        return answer;
+        goto cleanup;
     }
 
-    while ((directoryEntity = readdir(directory)) != NULL) 
+    for (size_t i = 0; i < answer.files.count; ++i)
     {
-        if (strcmp(directoryEntity->d_name, ".")  == 0 ||
-            strcmp(directoryEntity->d_name, "..") == 0)
+        jlsAlignmentUpdate(&answer.alignment, answer.files.list[i], isOkPtr);
+        if (!*isOkPtr)
         {
-            continue;
+            goto cleanup;
+        }
+    }
+
+    if (jlsIsSafeModeEnabled)
+    {
+        answer.safeType = jlsCalculateSafeType(&answer.files, isOkPtr);
+        if (!*isOkPtr)
+        {
+            goto cleanup;
         }
-        ++answer;        
     }
 
-    if (directory)
+    answer.total = jlsCalculate1024ByteBlocks(&answer.files, isOkPtr);
+
+cleanup:
+    if (!*isOkPtr)
     {
-        closedir(directory);
+        jlsFilesListClear(&answer.files);
+        return (jlsCommonInfoStruct){0};
     }
 
     return answer;
 }
 
-jlsAlignmentStruct jlsCalculateAlignment(const char *pathPtr, const jlsFilesListStruct *filesList, bool *isOkPtr)
+jlsFilesListStruct jlsGetFilesList(const char *dirPtr, bool *isOkPtr)
 {
     bool isOk = true;
 
@@ -937,115 +1459,137 @@ jlsAlignmentStruct jlsCalculateAlignment(const char *pathPtr, const jlsFilesList
     }
 
     *isOkPtr = true;
-
-    jlsAlignmentStruct answer = jlsAlignmentDefault;
-
+    
+    dirReaderEntryStruct directoryEntity = {0};
+    size_t               namesCapacity   = 0;
+    
     // Объявление переменных, используемых в cleanup
-    fileInfoStruct fileInfo = {0};
+    jlsFilesListStruct  answer      = {0};
+    dirReaderStruct     directory   = {0};
+    fileInfoStruct     *fileInfoPtr = 0;
+    arenaStruct         names       = {0};
+    const char        **namesList   = 0;
 
-    if (!pathPtr || !filesList)
+    if (!dirPtr)
     {
         *isOkPtr = false;
         goto cleanup;
     }
 
-    char   fullPath[PATH_MAX] = {0};
-    size_t pathLength         = 0;
-
-    pathLength = jlsPathSet(pathPtr, &fullPath[0], PATH_MAX, isOkPtr);
+    dirReaderOpen(&directory, dirPtr, jlsDirBufferSize, isOkPtr);
     if (!*isOkPtr)
     {
         goto cleanup;
     }
 
-    for (int i = 0; i < filesList->count; ++i)
+    // Сначала собираются имена всех файлов, чтобы информацию о них можно было запросить пакетно
+    while (dirReaderNext(&directory, &directoryEntity, isOkPtr)) 
     {
-        static char fileInfoString[JLS_FILE_INFO_MAX_LENGTH] = {0};
-
-        if (fileInfo.fileNamePtr)
-        {
-            free(fileInfo.fileNamePtr);
-            fileInfo.fileNamePtr = 0;
-        }
-        if (fileInfo.targetInfo.filePathPtr)
-        {
-            free(fileInfo.targetInfo.filePathPtr);
-            fileInfo.targetInfo.filePathPtr = 0;
-        }
-    
-        jlsPathAppend(filesList->list[i], &fullPath[0], pathLength, PATH_MAX, isOkPtr);
-        if (!*isOkPtr)
+        if (directoryEntity.namePtr[0] == '.' &&
+            (directoryEntity.nameLength == 1 || (directoryEntity.nameLength == 2 && directoryEntity.namePtr[1] == '.')))
         {
-            goto cleanup;
+            continue;
         }
 
-        fileInfoGet(&fullPath[0], &fileInfo, false, isOkPtr);
-        if (!*isOkPtr)
+        fileInfoPtr = calloc(1, sizeof(fileInfoStruct));
+        if (!fileInfoPtr)
         {
+            *isOkPtr = false;
             goto cleanup;
         }
 
-        fileInfoToString(&fileInfo, &fileInfoString[0], JLS_FILE_INFO_MAX_LENGTH, isOkPtr);
+        jlsFilesListAppend(&answer, fileInfoPtr, isOkPtr);
         if (!*isOkPtr)
         {
             goto cleanup;
         }
+        fileInfoPtr = 0;
 
-        static const char delimer[] = {FILE_INFO_TO_STRING_DELIMER, '\0'};
-        char             *field     = 0;
-
-        // Пропускаем тип файла
-        field = strtok(&fileInfoString[0], delimer);
-        // Пропускаем права доступа файла
-        field = strtok(NULL, delimer);
-
-        field = strtok(NULL, delimer);
-        if (answer.linksCount < strlen(field))
+        // namesList растет вместе со списком файлов
+        if (namesCapacity < answer.capacity)
         {
-            answer.linksCount = strlen(field);
+            const char **newNamesList = realloc(namesList, answer.capacity * sizeof(const char *));
+            if (!newNamesList)
+            {
+                *isOkPtr = false;
+                goto cleanup;
+            }
+            namesList     = newNamesList;
+            namesCapacity = answer.capacity;
         }
 
-        field = strtok(NULL, delimer);
-        if (answer.owner < strlen(field))
+        namesList[answer.count - 1] = arenaStringCopy(&names, directoryEntity.namePtr, directoryEntity.nameLength, isOkPtr);
+        if (!*isOkPtr)
         {
-            answer.owner = strlen(field);
+            goto cleanup;
         }
+    }
+    if (!*isOkPtr)
+    {
+        goto cleanup;
+    }
 
-        field = strtok(NULL, delimer);
-        if (answer.group < strlen(field))
-        {
-            answer.group = strlen(field);
-        }
+    jlsGetFilesInfo(directory.fd, namesList, answer.list, answer.count, isOkPtr);
 
-        field = strtok(NULL, delimer);
-        if (answer.size < strlen(field))
-        {
-            answer.size = strlen(field);
-        }
+cleanup:
+    dirReaderClose(&directory);
+
+    if (fileInfoPtr)
+    {
+        fileInfoClear(fileInfoPtr);
+        free(fileInfoPtr);
+        fileInfoPtr = 0;
     }
 
-cleanup:
-    if (fileInfo.fileNamePtr)
+    if (namesList)
     {
-        free(fileInfo.fileNamePtr);
-        fileInfo.fileNamePtr = 0;
+        free(namesList);
+        namesList = 0;
     }
-    if (fileInfo.targetInfo.filePathPtr)
+
+    arenaClear(&names);
+
+    if (!*isOkPtr)
     {
-        free(fileInfo.targetInfo.filePathPtr);
-        fileInfo.targetInfo.filePathPtr = 0;
+        jlsFilesListClear(&answer);
+        return (jlsFilesListStruct){0};
     }
-    if (*isOkPtr)
+
+    return answer;
+}
+
+void jlsFilesListClear(jlsFilesListStruct *filesListPtr)
+{
+    if (!filesListPtr)
     {
-        return answer;
+        return;
     }
-    else
+
+    if (filesListPtr->list)
     {
-        return (jlsAlignmentStruct){0};
+        for (size_t i = 0; i < filesListPtr->count; ++i)
+        {
+            fileInfoStruct *fileInfoPtr = filesListPtr->list[i];
+
+            if (!fileInfoPtr)
+            {
+                continue;
+            }
+
+            fileInfoClear(fileInfoPtr);
+            free(fileInfoPtr);
+            filesListPtr->list[i] = 0;
+        }
+
+        free(filesListPtr->list);
+        filesListPtr->list = 0;
     }
+
+    filesListPtr->count    = 0;
+    filesListPtr->capacity = 0;
 }
 
-jlsSafeTypesEnum jlsCalculateSafeType(const char *pathPtr, const jlsFilesListStruct *filesList, bool *isOkPtr)
+void jlsFilesListAppend(jlsFilesListStruct *filesListPtr, fileInfoStruct *fileInfoPtr, bool *isOkPtr)
 {
     bool isOk = true;
 
@@ -1056,97 +1600,211 @@ jlsSafeTypesEnum jlsCalculateSafeType(const char *pathPtr, const jlsFilesListStr
 
     *isOkPtr = true;
 
-    jlsSafeTypesEnum answer = jlsSafeTypeNone;
-
-    if (!pathPtr || !filesList)
+    if (!filesListPtr || !fileInfoPtr)
     {
         *isOkPtr = false;
-        goto cleanup;
+        return;
     }
 
-    char   fullPath[PATH_MAX] = {0};
-    size_t pathLength         = 0;
-
-    pathLength = jlsPathSet(pathPtr, &fullPath[0], PATH_MAX, isOkPtr);
-    if (!*isOkPtr)
+    if (filesListPtr->count == filesListPtr->capacity)
     {
-        goto cleanup;
-    }
+        size_t           newCapacity = 0;
+        fileInfoStruct **newList     = 0;
 
-    bool isFileUnsafe   = false;
-    bool isTargetUnsafe = false;
+        newCapacity = filesListPtr->capacity ? filesListPtr->capacity * 2 : JLS_FILES_LIST_CAPACITY_INITIAL;
 
-    for (int i = 0; i < filesList->count; ++i)
-    {
-        jlsPathAppend(filesList->list[i], &fullPath[0], pathLength, PATH_MAX, isOkPtr);
-        if (!*isOkPtr)
+        newList = realloc(filesListPtr->list, newCapacity * sizeof(fileInfoStruct *));
+        if (!newList)
         {
-            goto cleanup;
+            *isOkPtr = false;
+            return;
         }
 
-        if (!fileInfoSetActiveFile(&fullPath[0]))
-        {
-            goto cleanup;
-        }
+        filesListPtr->list     = newList;
+        filesListPtr->capacity = newCapacity;
+    }
+
+    filesListPtr->list[filesListPtr->count++] = fileInfoPtr;
+}
 
-        fileInfoTypesEnum type = fileInfoTypeUnknown;
+void jlsSortFilesList(jlsFilesListStruct *filesListPtr, const jlsSortSpecStruct *specPtr, jlsSortEnum sort, bool *isOkPtr)
+{
+    bool isOk = true;
 
-        type = fileInfoGetType(isOkPtr);
-        if (!*isOkPtr)
+    if (!isOkPtr)
+    {
+        isOkPtr = &isOk;
+    }
+
+    *isOkPtr = true;
+    
+    if (!filesListPtr || !filesListPtr->list || filesListPtr->count < 2)
+    {
+        *isOkPtr = false;
+        return;
+    }
+
+    if ((sort != jlsSortAscend && sort != jlsSortDescend) || (specPtr && !specPtr->count))
+    {
+        return;
+    }
+
+    bool   isByteCollation = jlsCheckIsByteCollation();
+    bool   isDescend       = sort == jlsSortDescend;
+    size_t threadsCount    = jlsGetThreadsCount();
+
+    // Имена в директории различны, поэтому поля после имени на порядок не влияют
+    if (specPtr && specPtr->fieldsList[0] == jlsSortFieldName)
+    {
+        isDescend = isDescend != specPtr->isReversedList[0];
+        specPtr   = 0;
+    }
+
+    if (threadsCount > 1 && filesListPtr->count >= jlsSortParallelThreshold)
+    {
+        jlsSortFilesListParallel(filesListPtr, specPtr, threadsCount, isByteCollation, isDescend, isOkPtr);
+        return;
+    }
+
+    // Объявление переменных, используемых в cleanup
+    jlsSortKeyStruct *keysList  = 0;
+    jlsSortKeyStruct *tempList  = 0;
+    arenaStruct       keysArena = {0};
+
+    keysList = malloc(filesListPtr->count * sizeof(jlsSortKeyStruct));
+    if (isByteCollation)
+    {
+        tempList = malloc(filesListPtr->count * sizeof(jlsSortKeyStruct));
+    }
+
+    if (!keysList || (isByteCollation && !tempList))
+    {
+        *isOkPtr = false;
+        goto cleanup;
+    }
+
+    jlsSortKeysFill(filesListPtr->list, keysList, filesListPtr->count, specPtr, isByteCollation, &keysArena, isOkPtr);
+    if (!*isOkPtr)
+    {
+        goto cleanup;
+    }
+
+    jlsSortKeysAscend(keysList, tempList, filesListPtr->count, isByteCollation);
+
+    // Убывающий порядок - обратный возрастающему. Порядок равных ключей не определен, как и у qsort()
+    for (size_t i = 0; i < filesListPtr->count; ++i)
+    {
+        filesListPtr->list[isDescend ? filesListPtr->count - 1 - i : i] = keysList[i].fileInfoPtr;
+    }
+
+cleanup:
+    free(keysList);
+    free(tempList);
+    arenaClear(&keysArena);
+}
+
+void jlsSortSpecParse(const char *stringPtr, jlsSortSpecStruct *specPtr, bool *isOkPtr)
+{
+    bool isOk = true;
+
+    if (!isOkPtr)
+    {
+        isOkPtr = &isOk;
+    }
+
+    *isOkPtr = true;
+
+    if (!stringPtr || !specPtr)
+    {
+        *isOkPtr = false;
+        return;
+    }
+
+    jlsSortSpecStruct answer = {0};
+
+    if (!strcmp(stringPtr, "none"))
+    {
+        *specPtr = answer;
+        return;
+    }
+
+    const char *fieldPtr = stringPtr;
+
+    while (true)
+    {
+        const char *endPtr      = strchr(fieldPtr, ',');
+        size_t      fieldLength = endPtr ? (size_t)(endPtr - fieldPtr) : strlen(fieldPtr);
+        bool        isReversed  = false;
+        size_t      field       = 0;
+
+        if (fieldLength && fieldPtr[0] == '-')
         {
-            goto cleanup;
+            isReversed = true;
+            ++fieldPtr;
+            --fieldLength;
         }
 
-        if (!isFileUnsafe)
+        for (; field < jlsSortFieldCount; ++field)
         {
-            isFileUnsafe = jlsCheckIsUnsafe(filesList->list[i], isOkPtr);
-            if (!*isOkPtr)
+            if (strlen(jlsSortFieldNamesList[field]) == fieldLength && !strncmp(jlsSortFieldNamesList[field], fieldPtr, fieldLength))
             {
-                goto cleanup;
+                break;
             }
         }
 
-        if (!isTargetUnsafe && type == fileInfoTypeLink)
+        if (field == jlsSortFieldCount || answer.count == JLS_SORT_FIELDS_MAX)
         {
-            static char targetString[JLS_FILE_INFO_MAX_LENGTH] = {0};
+            *isOkPtr = false;
+            return;
+        }
 
-            fileInfoGetLinkTarget(&targetString[0], JLS_FILE_INFO_MAX_LENGTH, isOkPtr);
-            if (!*isOkPtr)
-            {
-                goto cleanup;
-            }
+        answer.fieldsList[answer.count]     = (jlsSortFieldsEnum)field;
+        answer.isReversedList[answer.count] = isReversed;
+        ++answer.count;
 
-            isTargetUnsafe = jlsCheckIsUnsafe(&targetString[0], isOkPtr);
-            if (!*isOkPtr)
-            {
-                goto cleanup;
-            }
+        if (!endPtr)
+        {
+            break;
         }
-    }
 
-    if (isFileUnsafe)
-    {
-        answer += jlsSafeTypeName;
+        fieldPtr = endPtr + 1;
     }
-    if (isTargetUnsafe)
+
+    *specPtr = answer;
+}
+
+jlsAlignmentStruct jlsCalculateAlignment(const jlsFilesListStruct *filesList, bool *isOkPtr)
+{
+    bool isOk = true;
+
+    if (!isOkPtr)
     {
-        answer += jlsSafeTypeTarget;
+        isOkPtr = &isOk;
     }
 
-cleanup:
-    fileInfoClearActiveFile();
+    *isOkPtr = true;
 
-    if (*isOkPtr)
+    jlsAlignmentStruct answer = jlsAlignmentDefault;
+
+    if (!filesList)
     {
-        return answer;
+        *isOkPtr = false;
+        return (jlsAlignmentStruct){0};
     }
-    else
+
+    for (size_t i = 0; i < filesList->count; ++i)
     {
-        return jlsSafeTypeNone;
+        jlsAlignmentUpdate(&answer, filesList->list[i], isOkPtr);
+        if (!*isOkPtr)
+        {
+            return (jlsAlignmentStruct){0};
+        }
     }
+
+    return answer;
 }
 
-uint64_t jlsCalculate1024ByteBlocks(const char *pathPtr, const jlsFilesListStruct *filesList, bool *isOkPtr)
+jlsSafeTypesEnum jlsCalculateSafeType(const jlsFilesListStruct *filesList, bool *isOkPtr)
 {
     bool isOk = true;
 
@@ -1157,61 +1815,58 @@ uint64_t jlsCalculate1024ByteBlocks(const char *pathPtr, const jlsFilesListStruc
 
     *isOkPtr = true;
 
-    uint64_t answer = {0};
+    jlsSafeTypesEnum answer = jlsSafeTypeNone;
 
-    if (!pathPtr || !filesList)
+    if (!filesList)
     {
         *isOkPtr = false;
-        goto cleanup;
+        return jlsSafeTypeNone;
     }
 
-    char   fullPath[PATH_MAX] = {0};
-    size_t pathLength         = 0;
+    bool isFileUnsafe   = false;
+    bool isTargetUnsafe = false;
 
-    pathLength = jlsPathSet(pathPtr, &fullPath[0], PATH_MAX, isOkPtr);
-    if (!*isOkPtr)
+    for (size_t i = 0; i < filesList->count; ++i)
     {
-        goto cleanup;
-    }
+        const fileInfoStruct *fileInfoPtr = filesList->list[i];
 
-    for (int i = 0; i < filesList->count; ++i)
-    {
-        static char fileInfoString[JLS_FILE_INFO_MAX_LENGTH] = {0};
-    
-        jlsPathAppend(filesList->list[i], &fullPath[0], pathLength, PATH_MAX, isOkPtr);
-        if (!*isOkPtr)
+        if (!isFileUnsafe)
         {
-            goto cleanup;
+            isFileUnsafe = jlsCheckIsUnsafe(fileInfoPtr->fileNamePtr, isOkPtr);
+            if (!*isOkPtr)
+            {
+                return jlsSafeTypeNone;
+            }
         }
 
-        if (!fileInfoSetActiveFile(&fullPath[0]))
+        if (!isTargetUnsafe && fileInfoPtr->type == fileInfoTypeLink)
         {
-            goto cleanup;
+            isTargetUnsafe = jlsCheckIsUnsafe(fileInfoPtr->targetInfo.fileNamePtr, isOkPtr);
+            if (!*isOkPtr)
+            {
+                return jlsSafeTypeNone;
+            }
         }
 
-        answer += fileInfoGet512BytesBlocks(isOkPtr);
-        if (!*isOkPtr)
+        if (isFileUnsafe && isTargetUnsafe)
         {
-            goto cleanup;
+            break;
         }
     }
 
-cleanup:
-
-    fileInfoClearActiveFile();
-
-    if (*isOkPtr)
+    if (isFileUnsafe)
     {
-        answer /= 2;
-        return answer;
+        answer += jlsSafeTypeName;
     }
-    else
+    if (isTargetUnsafe)
     {
-        return 0;
+        answer += jlsSafeTypeTarget;
     }
+
+    return answer;
 }
 
-size_t jlsMakeStringSafe(const char *stringPtr, char *safePtr, size_t safePtrLength, bool *isOkPtr)
+uint64_t jlsCalculate1024ByteBlocks(const jlsFilesListStruct *filesList, bool *isOkPtr)
 {
     bool isOk = true;
 
@@ -1222,85 +1877,118 @@ size_t jlsMakeStringSafe(const char *stringPtr, char *safePtr, size_t safePtrLen
 
     *isOkPtr = true;
 
-    if (!stringPtr || !safePtr || strlen(stringPtr) + 1 > safePtrLength)
+    uint64_t answer = 0;
+
+    if (!filesList)
     {
         *isOkPtr = false;
         return 0;
     }
 
-    bool isUnsafe = true;
-
-    isUnsafe = jlsCheckIsUnsafe(stringPtr, isOkPtr);
-    if (!*isOkPtr)
+    for (size_t i = 0; i < filesList->count; ++i)
     {
-        return 0;
+        answer += filesList->list[i]->blocks;
     }
-    if (!isUnsafe)
+
+    answer /= 2;
+
+    return answer;
+}
+
+size_t jlsMakeStringSafe(const char *stringPtr, char *safePtr, size_t safePtrLength, bool *isOkPtr)
+{
+    bool isOk = true;
+
+    if (!isOkPtr)
     {
-        strcpy(safePtr, stringPtr);
-        return strlen(safePtr) + 1;
+        isOkPtr = &isOk;
     }
 
-    // \0 и 2 экранирующих символа 
-    if (strlen(stringPtr) + 3 > safePtrLength)
+    *isOkPtr = true;
+
+    if (!stringPtr || !safePtr || !safePtrLength)
     {
         *isOkPtr = false;
         return 0;
     }
 
-    memset(safePtr, 0, safePtrLength);
+    size_t  length      = 0;
+    size_t  quotesCount = 0;
+    uint8_t classes     = 0;
+
+    // Копирование строки с одновременной классификацией ее байтов
+    for (; stringPtr[length]; ++length)
+    {
+        unsigned char symbol = (unsigned char)stringPtr[length];
+
+        if (length + 1 >= safePtrLength)
+        {
+            *isOkPtr = false;
+            return 0;
+        }
+
+        safePtr[length]  = (char)symbol;
+        classes         |= jlsQuoteClassesList[symbol];
+        quotesCount     += symbol == '\'';
+    }
+    safePtr[length] = '\0';
 
-    size_t answer = 0;
+    bool isUnsafe = classes & jlsQuoteClassUnsafe;
 
-    if (!strchr(stringPtr, '\''))
+    if (!isUnsafe && (classes & jlsQuoteClassMultibyte))
     {
-        safePtr[answer++] = '\'';
-        memcpy(&safePtr[answer], stringPtr, strlen(stringPtr));
-        answer += strlen(stringPtr);
-        safePtr[answer++] = '\'';
+        isUnsafe = jlsCheckIsUnsafe(stringPtr, isOkPtr);
+        if (!*isOkPtr)
+        {
+            return 0;
+        }
+    }
 
-        return answer;
+    if (!isUnsafe)
+    {
+        return length;
     }
 
-    if (!strchr(stringPtr, '"') && 
-        !strchr(stringPtr, '$') && 
-        !strchr(stringPtr, '`') && 
-        !strchr(stringPtr, '\\'))
+    char quote = '\'';
+
+    if (quotesCount && !(classes & jlsQuoteClassDoubleSpecial))
     {
-        safePtr[answer++] = '"';
-        memcpy(&safePtr[answer], stringPtr, strlen(stringPtr));
-        answer += strlen(stringPtr);
-        safePtr[answer++] = '"';
+        quote       = '"';
+        quotesCount = 0;
+    }
+
+    // Каждая одинарная кавычка заменяется на '\''
+    size_t safeLength = length + 2 + quotesCount * 3;
 
-        return answer;
+    if (safeLength + 1 > safePtrLength)
+    {
+        *isOkPtr = false;
+        return 0;
     }
 
-    safePtr[answer++] = '\'';
-    for (int i = 0; i < strlen(stringPtr); ++i)
+    // Расширение строки на месте с конца, чтобы не перезаписать еще не перенесенные символы
+    size_t position = safeLength;
+
+    safePtr[position]   = '\0';
+    safePtr[--position] = quote;
+
+    for (size_t i = length; i > 0; --i)
     {
         static const char safeQuote[] = "\'\\\'\'";
 
-        if (stringPtr[i] != '\'')
+        if (quotesCount && safePtr[i - 1] == '\'')
         {
-            safePtr[answer++] = stringPtr[i];
+            position -= sizeof(safeQuote) - 1;
+            memcpy(&safePtr[position], &safeQuote[0], sizeof(safeQuote) - 1);
             continue;
         }
 
-        // \0 и закрывающий экранирующий символ
-        if (answer + strlen(safeQuote) >= safePtrLength - 2)
-        {
-            *isOkPtr = false;
-            break;
-        }
-
-        memcpy(&safePtr[answer], &safeQuote[0], strlen(safeQuote));
-
-        answer += strlen(safeQuote);
+        safePtr[--position] = safePtr[i - 1];
     }
-    safePtr[answer++] = '\'';
-    safePtr[answer++] = '\0';
 
-    return answer;
+    safePtr[0] = quote;
+
+    return safeLength;
 }
 
 /*
@@ -1345,7 +2033,7 @@ updateMaxVisibleChars:
     jlsMaxVisibleChars = newMaxVisibleChars;
 }
 
-static size_t jlsPathSet(const char *pathPtr, char *bufferPtr, size_t bufferSize, bool *isOkPtr)
+static void jlsAlignmentUpdate(jlsAlignmentStruct *alignmentPtr, const fileInfoStruct *fileInfoPtr, bool *isOkPtr)
 {
     bool isOk = true;
 
@@ -1356,77 +2044,780 @@ static size_t jlsPathSet(const char *pathPtr, char *bufferPtr, size_t bufferSize
 
     *isOkPtr = true;
 
-    size_t answer = 0;
-
-    if (!pathPtr || !bufferPtr || bufferSize < 2)
+    if (!alignmentPtr || !fileInfoPtr)
     {
         *isOkPtr = false;
-        return 0;
+        return;
     }
 
-    memset(bufferPtr, 0, bufferSize);
-
-    answer = snprintf(bufferPtr, bufferSize, "%s/", pathPtr);
-
-    return answer;
-}
-
-static size_t jlsPathAppend(const char *filePtr, char *bufferPtr, size_t bufferLength, size_t bufferSize, bool *isOkPtr)
-{
-    bool isOk = true;
+    fileInfoColumnsStruct columns = {0};
 
-    if (!isOkPtr)
+    fileInfoToColumns(fileInfoPtr, &columns, isOkPtr);
+    if (!*isOkPtr)
     {
-        isOkPtr = &isOk;
+        return;
     }
 
-    *isOkPtr = true;
-
-    size_t answer = 0;
-
-    if (!filePtr || !bufferPtr || bufferSize < bufferLength)
+    if (alignmentPtr->linksCount < columns.lengthsList[fileInfoColumnLinksCount])
     {
-        *isOkPtr = false;
-        return answer;
+        alignmentPtr->linksCount = columns.lengthsList[fileInfoColumnLinksCount];
     }
 
-    answer  = snprintf(&bufferPtr[bufferLength], bufferSize - bufferLength, "%s", filePtr);
-    answer += bufferLength;
-    bufferPtr[answer++] = '\0';
+    if (alignmentPtr->owner < columns.lengthsList[fileInfoColumnOwner])
+    {
+        alignmentPtr->owner = columns.lengthsList[fileInfoColumnOwner];
+    }
 
-    return answer;
-}
+    if (alignmentPtr->group < columns.lengthsList[fileInfoColumnGroup])
+    {
+        alignmentPtr->group = columns.lengthsList[fileInfoColumnGroup];
+    }
 
-static int jlsFilesListCompareAscend(const void *a, const void *b)
-{
-    return strcoll(*(const char **)a, *(const char **)b);
+    if (alignmentPtr->size < columns.lengthsList[fileInfoColumnSize])
+    {
+        alignmentPtr->size = columns.lengthsList[fileInfoColumnSize];
+    }
 }
 
-static int jlsFilesListCompareDescend(const void *a, const void *b)
+static int jlsSortKeysCompareAscend(const void *a, const void *b)
 {
-    return jlsFilesListCompareAscend(b, a);
+    return jlsSortKeysCompare(a, b, 0);
 }
 
-static bool jlsCheckIsUnsafe(const char *stringPtr, bool *isOkPtr)
+static int jlsSortKeysCompare(const jlsSortKeyStruct *keyAPtr, const jlsSortKeyStruct *keyBPtr, size_t depth)
 {
-    bool isOk = true;
+    size_t length = keyAPtr->keyLength < keyBPtr->keyLength ? keyAPtr->keyLength : keyBPtr->keyLength;
 
-    if (!isOkPtr)
+    if (length > depth)
     {
-        isOkPtr = &isOk;
+        int answer = memcmp(&keyAPtr->keyPtr[depth], &keyBPtr->keyPtr[depth], length - depth);
+        if (answer)
+        {
+            return answer;
+        }
     }
 
+    return (keyAPtr->keyLength > keyBPtr->keyLength) - (keyAPtr->keyLength < keyBPtr->keyLength);
+}
+
+static void jlsSortKeysFill(fileInfoStruct *const *filesList, jlsSortKeyStruct *keysList, size_t count, const jlsSortSpecStruct *specPtr,
+                            bool isByteCollation, arenaStruct *keysArenaPtr, bool *isOkPtr)
+{
     *isOkPtr = true;
 
-    if (!stringPtr)
-    {
-        *isOkPtr = false;
-        return false;
-    }
-    
-    size_t stringLength = strlen(stringPtr);
-    
-    while (stringLength > 0)
+    // Объявление переменных, используемых в cleanup
+    jlsSortKeyBufferStruct buffer = {0};
+
+    // strcoll() и сравнение полей при каждом сравнении заменяются однократной сборкой ключа для каждого файла
+    for (size_t i = 0; i < count; ++i)
+    {
+        const char *fileNamePtr = filesList[i]->fileNamePtr;
+
+        keysList[i].fileInfoPtr = filesList[i];
+
+        // Побайтовый порядок по имени: ключом является само имя
+        if (isByteCollation && !specPtr)
+        {
+            keysList[i].keyPtr    = fileNamePtr;
+            keysList[i].keyLength = strlen(fileNamePtr);
+            continue;
+        }
+
+        jlsSortKeyBuild(&buffer, filesList[i], specPtr, isByteCollation, isOkPtr);
+        if (!*isOkPtr)
+        {
+            goto cleanup;
+        }
+
+        keysList[i].keyPtr = arenaStringCopy(keysArenaPtr, buffer.dataPtr, buffer.length, isOkPtr);
+        if (!*isOkPtr)
+        {
+            goto cleanup;
+        }
+
+        keysList[i].keyLength = buffer.length;
+    }
+
+cleanup:
+    free(buffer.dataPtr);
+}
+
+static void jlsSortKeyBuild(jlsSortKeyBufferStruct *bufferPtr, const fileInfoStruct *fileInfoPtr, const jlsSortSpecStruct *specPtr,
+                            bool isByteCollation, bool *isOkPtr)
+{
+    *isOkPtr = true;
+
+    bufferPtr->length = 0;
+
+    for (size_t field = 0; specPtr && field < specPtr->count && *isOkPtr; ++field)
+    {
+        jlsSortKeyAppendField(bufferPtr, fileInfoPtr, specPtr->fieldsList[field], specPtr->isReversedList[field], isByteCollation, isOkPtr);
+    }
+
+    // Равные по всем полям файлы сравниваются по имени
+    if (*isOkPtr)
+    {
+        jlsSortKeyAppendString(bufferPtr, fileInfoPtr->fileNamePtr, false, isByteCollation, isOkPtr);
+    }
+}
+
+static void jlsSortKeyAppendField(jlsSortKeyBufferStruct *bufferPtr, const fileInfoStruct *fileInfoPtr, jlsSortFieldsEnum field,
+                                  bool isReversed, bool isByteCollation, bool *isOkPtr)
+{
+    // Инверсия знакового бита переводит порядок знаковых чисел в порядок беззнаковых
+    static const uint64_t signBit = (uint64_t)1 << 63;
+
+    switch (field)
+    {
+        case jlsSortFieldName:
+        default:
+        {
+            jlsSortKeyAppendString(bufferPtr, fileInfoPtr->fileNamePtr, isReversed, isByteCollation, isOkPtr);
+            break;
+        }
+
+        case jlsSortFieldExtension:
+        {
+            const char *extensionPtr = strrchr(fileInfoPtr->fileNamePtr, '.');
+
+            jlsSortKeyAppendString(bufferPtr, extensionPtr ? extensionPtr : "", isReversed, isByteCollation, isOkPtr);
+            break;
+        }
+
+        case jlsSortFieldVersion:
+        {
+            jlsSortKeyAppendVersion(bufferPtr, fileInfoPtr->fileNamePtr, isReversed, isOkPtr);
+            break;
+        }
+
+        case jlsSortFieldTimeEdit:
+        {
+            jlsSortKeyAppendNumber(bufferPtr, (uint64_t)fileInfoPtr->timeEdit ^ signBit, !isReversed, isOkPtr);
+            if (*isOkPtr)
+            {
+                jlsSortKeyAppendNumber(bufferPtr, (uint64_t)fileInfoPtr->timeEditNsec, !isReversed, isOkPtr);
+            }
+            break;
+        }
+
+        case jlsSortFieldSize:
+        {
+            jlsSortKeyAppendNumber(bufferPtr, (uint64_t)fileInfoPtr->size ^ signBit, !isReversed, isOkPtr);
+            break;
+        }
+    }
+}
+
+static void jlsSortKeyAppendString(jlsSortKeyBufferStruct *bufferPtr, const char *stringPtr, bool isReversed, bool isByteCollation, bool *isOkPtr)
+{
+    size_t length = 0;
+
+    if (isByteCollation)
+    {
+        length = strlen(stringPtr);
+
+        jlsSortKeyBufferReserve(bufferPtr, length + 1, isOkPtr);
+        if (!*isOkPtr)
+        {
+            return;
+        }
+
+        memcpy(&bufferPtr->dataPtr[bufferPtr->length], stringPtr, length);
+    }
+    else
+    {
+        jlsSortKeyBufferReserve(bufferPtr, 1, isOkPtr);
+        if (!*isOkPtr)
+        {
+            return;
+        }
+
+        length = strxfrm(&bufferPtr->dataPtr[bufferPtr->length], stringPtr, bufferPtr->size - bufferPtr->length);
+        if (length >= bufferPtr->size - bufferPtr->length)
+        {
+            jlsSortKeyBufferReserve(bufferPtr, length + 1, isOkPtr);
+            if (!*isOkPtr)
+            {
+                return;
+            }
+
+            strxfrm(&bufferPtr->dataPtr[bufferPtr->length], stringPtr, bufferPtr->size - bufferPtr->length);
+        }
+    }
+
+    // Завершающий байт 0 меньше любого байта строки, поэтому строка-префикс меньше продолжающей ее строки
+    bufferPtr->dataPtr[bufferPtr->length + length] = '\0';
+
+    if (isReversed)
+    {
+        for (size_t i = 0; i <= length; ++i)
+        {
+            bufferPtr->dataPtr[bufferPtr->length + i] = (char)~bufferPtr->dataPtr[bufferPtr->length + i];
+        }
+    }
+
+    bufferPtr->length += length + 1;
+}
+
+static void jlsSortKeyAppendVersion(jlsSortKeyBufferStruct *bufferPtr, const char *stringPtr, bool isReversed, bool *isOkPtr)
+{
+    const unsigned char *symbolPtr = (const unsigned char *)stringPtr;
+    size_t               length    = strlen(stringPtr);
+
+    // Худший случай - однозначные числа через символ JLS_VERSION_KEY_MARKER: 7 байт ключа на 2 байта строки
+    jlsSortKeyBufferReserve(bufferPtr, 4 * length + 3, isOkPtr);
+    if (!*isOkPtr)
+    {
+        return;
+    }
+
+    unsigned char *keyPtr    = (unsigned char *)&bufferPtr->dataPtr[bufferPtr->length];
+    size_t         keyLength = 0;
+
+    while (*symbolPtr)
+    {
+        if (*symbolPtr < '0' || *symbolPtr > '9')
+        {
+            // Символ текста, совпадающий с маркером, дополняется байтом больше, чем у числа
+            if (*symbolPtr == JLS_VERSION_KEY_MARKER)
+            {
+                keyPtr[keyLength++] = JLS_VERSION_KEY_MARKER;
+            }
+
+            keyPtr[keyLength++] = *symbolPtr++;
+            continue;
+        }
+
+        while (*symbolPtr == '0')
+        {
+            ++symbolPtr;
+        }
+
+        const unsigned char *digitsPtr = symbolPtr;
+
+        while (*symbolPtr >= '0' && *symbolPtr <= '9')
+        {
+            ++symbolPtr;
+        }
+
+        size_t digitsCount = (size_t)(symbolPtr - digitsPtr);
+
+        keyPtr[keyLength++] = JLS_VERSION_KEY_MARKER;
+        keyPtr[keyLength++] = 0;
+        keyPtr[keyLength++] = (unsigned char)(digitsCount >> 8);
+        keyPtr[keyLength++] = (unsigned char)digitsCount;
+
+        memcpy(&keyPtr[keyLength], digitsPtr, digitsCount);
+        keyLength += digitsCount;
+    }
+
+    keyPtr[keyLength++] = 0;
+
+    if (isReversed)
+    {
+        for (size_t i = 0; i < keyLength; ++i)
+        {
+            keyPtr[i] = (unsigned char)~keyPtr[i];
+        }
+    }
+
+    bufferPtr->length += keyLength;
+}
+
+static void jlsSortKeyAppendNumber(jlsSortKeyBufferStruct *bufferPtr, uint64_t value, bool isReversed, bool *isOkPtr)
+{
+    jlsSortKeyBufferReserve(bufferPtr, sizeof(uint64_t), isOkPtr);
+    if (!*isOkPtr)
+    {
+        return;
+    }
+
+    if (isReversed)
+    {
+        value = ~value;
+    }
+
+    for (size_t i = 0; i < sizeof(uint64_t); ++i)
+    {
+        bufferPtr->dataPtr[bufferPtr->length++] = (char)(value >> (8 * (sizeof(uint64_t) - 1 - i)));
+    }
+}
+
+static void jlsSortKeyBufferReserve(jlsSortKeyBufferStruct *bufferPtr, size_t size, bool *isOkPtr)
+{
+    *isOkPtr = true;
+
+    if (bufferPtr->size - bufferPtr->length >= size)
+    {
+        return;
+    }
+
+    size_t newSize = bufferPtr->size ? bufferPtr->size * 2 : JLS_SORT_KEY_BUFFER_SIZE_INITIAL;
+
+    if (newSize < bufferPtr->length + size)
+    {
+        newSize = bufferPtr->length + size;
+    }
+
+    char *newDataPtr = realloc(bufferPtr->dataPtr, newSize);
+    if (!newDataPtr)
+    {
+        *isOkPtr = false;
+        return;
+    }
+
+    bufferPtr->dataPtr = newDataPtr;
+    bufferPtr->size    = newSize;
+}
+
+static void jlsSortKeysAscend(jlsSortKeyStruct *keysList, jlsSortKeyStruct *tempList, size_t count, bool isByteCollation)
+{
+    if (isByteCollation)
+    {
+        jlsRadixSortKeys(keysList, tempList, count, 0);
+    }
+    else
+    {
+        qsort(keysList, count, sizeof(jlsSortKeyStruct), jlsSortKeysCompareAscend);
+    }
+}
+
+static void jlsSortFilesListParallel(jlsFilesListStruct *filesListPtr, const jlsSortSpecStruct *specPtr, size_t threadsCount,
+                                     bool isByteCollation, bool isDescend, bool *isOkPtr)
+{
+    *isOkPtr = true;
+
+    // Объявление переменных, используемых в cleanup
+    jlsSortPartStruct partsList[JLS_STAT_THREADS_MAX] = {0};
+    jlsSortKeyStruct *samplesList                     = 0;
+    jlsSortWorkStruct work                            =
+    {
+        .specPtr         = specPtr,
+        .filesList       = filesListPtr->list,
+        .count           = filesListPtr->count,
+        .partsCount      = threadsCount,
+        .isByteCollation = isByteCollation,
+        .isDescend       = isDescend
+    };
+
+    work.keysList   = malloc(work.count * sizeof(jlsSortKeyStruct));
+    work.tempList   = malloc(work.count * sizeof(jlsSortKeyStruct));
+    work.boundsList = malloc(threadsCount * (threadsCount + 1) * sizeof(size_t));
+    samplesList     = malloc(threadsCount * threadsCount * sizeof(jlsSortKeyStruct));
+    if (!work.keysList || !work.tempList || !work.boundsList || !samplesList)
+    {
+        *isOkPtr = false;
+        goto cleanup;
+    }
+
+    for (size_t i = 0; i < threadsCount; ++i)
+    {
+        partsList[i].workPtr = &work;
+        partsList[i].index   = i;
+        partsList[i].isOk    = true;
+    }
+
+    jlsSortRunParts(jlsSortChunkWorker, &partsList[0], threadsCount);
+
+    for (size_t i = 0; i < threadsCount; ++i)
+    {
+        if (!partsList[i].isOk)
+        {
+            *isOkPtr = false;
+            goto cleanup;
+        }
+    }
+
+    // Регулярная выборка: threadsCount равноотстоящих ключей из каждой отсортированной части
+    for (size_t chunk = 0; chunk < threadsCount; ++chunk)
+    {
+        size_t begin = work.count * chunk / threadsCount;
+        size_t end   = work.count * (chunk + 1) / threadsCount;
+
+        for (size_t i = 0; i < threadsCount; ++i)
+        {
+            samplesList[chunk * threadsCount + i] = work.keysList[begin + (end - begin) * i / threadsCount];
+        }
+    }
+
+    qsort(samplesList, threadsCount * threadsCount, sizeof(jlsSortKeyStruct), jlsSortKeysCompareAscend);
+
+    // Граница part части слияния в каждой отсортированной части - первый ключ, не меньший samplesList[part * threadsCount]
+    for (size_t chunk = 0; chunk < threadsCount; ++chunk)
+    {
+        size_t  begin      = work.count * chunk / threadsCount;
+        size_t  end        = work.count * (chunk + 1) / threadsCount;
+        size_t *boundsList = &work.boundsList[chunk * (threadsCount + 1)];
+
+        boundsList[0]            = begin;
+        boundsList[threadsCount] = end;
+
+        for (size_t part = 1; part < threadsCount; ++part)
+        {
+            boundsList[part] = begin + jlsSortKeysLowerBound(&work.keysList[begin], end - begin, &samplesList[part * threadsCount]);
+        }
+    }
+
+    jlsSortRunParts(jlsSortMergeWorker, &partsList[0], threadsCount);
+
+cleanup:
+    for (size_t i = 0; i < threadsCount; ++i)
+    {
+        arenaClear(&partsList[i].keysArena);
+    }
+
+    free(work.keysList);
+    free(work.tempList);
+    free(work.boundsList);
+    free(samplesList);
+}
+
+static void *jlsSortChunkWorker(void *partPtr)
+{
+    jlsSortPartStruct *sortPartPtr = partPtr;
+    jlsSortWorkStruct *workPtr     = sortPartPtr->workPtr;
+    size_t             begin       = workPtr->count * sortPartPtr->index / workPtr->partsCount;
+    size_t             end         = workPtr->count * (sortPartPtr->index + 1) / workPtr->partsCount;
+
+    jlsSortKeysFill(&workPtr->filesList[begin], &workPtr->keysList[begin], end - begin, workPtr->specPtr, workPtr->isByteCollation,
+                    &sortPartPtr->keysArena, &sortPartPtr->isOk);
+    if (!sortPartPtr->isOk)
+    {
+        return 0;
+    }
+
+    jlsSortKeysAscend(&workPtr->keysList[begin], &workPtr->tempList[begin], end - begin, workPtr->isByteCollation);
+
+    return 0;
+}
+
+static void *jlsSortMergeWorker(void *partPtr)
+{
+    jlsSortPartStruct *sortPartPtr = partPtr;
+    jlsSortWorkStruct *workPtr     = sortPartPtr->workPtr;
+    size_t             part        = sortPartPtr->index;
+    size_t             stride      = workPtr->partsCount + 1;
+    size_t             position    = 0;
+    size_t             heapList[JLS_STAT_THREADS_MAX];
+    size_t             heapCount   = 0;
+    size_t             cursorsList[JLS_STAT_THREADS_MAX];
+    size_t             endsList[JLS_STAT_THREADS_MAX];
+
+    // Начало части слияния в результате - сумма размеров предыдущих частей слияния во всех отсортированных частях
+    for (size_t chunk = 0; chunk < workPtr->partsCount; ++chunk)
+    {
+        const size_t *boundsList = &workPtr->boundsList[chunk * stride];
+
+        position += boundsList[part] - boundsList[0];
+
+        cursorsList[chunk] = boundsList[part];
+        endsList[chunk]    = boundsList[part + 1];
+
+        if (cursorsList[chunk] < endsList[chunk])
+        {
+            heapList[heapCount++] = chunk;
+        }
+    }
+
+    // Двоичная куча номеров отсортированных частей по их текущему ключу
+    for (size_t i = heapCount / 2; i-- > 0;)
+    {
+        jlsSortHeapSiftDown(workPtr->keysList, &cursorsList[0], &heapList[0], heapCount, i);
+    }
+
+    while (heapCount)
+    {
+        size_t chunk = heapList[0];
+        size_t index = workPtr->isDescend ? workPtr->count - 1 - position : position;
+
+        workPtr->filesList[index] = workPtr->keysList[cursorsList[chunk]++].fileInfoPtr;
+        ++position;
+
+        if (cursorsList[chunk] == endsList[chunk])
+        {
+            heapList[0] = heapList[--heapCount];
+        }
+
+        jlsSortHeapSiftDown(workPtr->keysList, &cursorsList[0], &heapList[0], heapCount, 0);
+    }
+
+    return 0;
+}
+
+static void jlsSortHeapSiftDown(const jlsSortKeyStruct *keysList, const size_t *cursorsList, size_t *heapList, size_t count, size_t start)
+{
+    size_t parent = start;
+    size_t child  = 2 * start + 1;
+
+    while (child < count)
+    {
+        if (child + 1 < count && jlsSortKeysCompare(&keysList[cursorsList[heapList[child + 1]]], &keysList[cursorsList[heapList[child]]], 0) < 0)
+        {
+            ++child;
+        }
+
+        if (jlsSortKeysCompare(&keysList[cursorsList[heapList[child]]], &keysList[cursorsList[heapList[parent]]], 0) >= 0)
+        {
+            break;
+        }
+
+        size_t swap = heapList[parent];
+
+        heapList[parent] = heapList[child];
+        heapList[child]  = swap;
+
+        parent = child;
+        child  = 2 * child + 1;
+    }
+}
+
+static void jlsSortRunParts(void *(*worker)(void *), jlsSortPartStruct *partsList, size_t partsCount)
+{
+    pthread_t threadsList[JLS_STAT_THREADS_MAX];
+    bool      isStartedList[JLS_STAT_THREADS_MAX] = {0};
+
+    for (size_t i = 1; i < partsCount; ++i)
+    {
+        isStartedList[i] = !pthread_create(&threadsList[i], 0, worker, &partsList[i]);
+    }
+
+    worker(&partsList[0]);
+
+    for (size_t i = 1; i < partsCount; ++i)
+    {
+        if (isStartedList[i])
+        {
+            pthread_join(threadsList[i], 0);
+        }
+        else
+        {
+            worker(&partsList[i]);
+        }
+    }
+}
+
+static size_t jlsSortKeysLowerBound(const jlsSortKeyStruct *keysList, size_t count, const jlsSortKeyStruct *keyPtr)
+{
+    size_t begin = 0;
+    size_t end   = count;
+
+    while (begin < end)
+    {
+        size_t middle = begin + (end - begin) / 2;
+
+        if (jlsSortKeysCompare(&keysList[middle], keyPtr, 0) < 0)
+        {
+            begin = middle + 1;
+        }
+        else
+        {
+            end = middle;
+        }
+    }
+
+    return begin;
+}
+
+static int jlsTopKeysCompare(const jlsSortKeyBufferStruct *keyAPtr, const jlsSortKeyBufferStruct *keyBPtr, bool isDescend)
+{
+    size_t length = keyAPtr->length < keyBPtr->length ? keyAPtr->length : keyBPtr->length;
+    int    answer = memcmp(keyAPtr->dataPtr, keyBPtr->dataPtr, length);
+
+    if (!answer)
+    {
+        answer = (keyAPtr->length > keyBPtr->length) - (keyAPtr->length < keyBPtr->length);
+    }
+
+    return isDescend ? -answer : answer;
+}
+
+static void jlsTopHeapSiftDown(const jlsTopEntryStruct *entriesList, size_t *heapList, size_t count, size_t start, bool isDescend)
+{
+    size_t index = heapList[start];
+
+    while (2 * start + 1 < count)
+    {
+        size_t child = 2 * start + 1;
+
+        if (child + 1 < count && jlsTopKeysCompare(&entriesList[heapList[child + 1]].key, &entriesList[heapList[child]].key, isDescend) > 0)
+        {
+            ++child;
+        }
+
+        if (jlsTopKeysCompare(&entriesList[heapList[child]].key, &entriesList[index].key, isDescend) <= 0)
+        {
+            break;
+        }
+
+        heapList[start] = heapList[child];
+        start           = child;
+    }
+
+    heapList[start] = index;
+}
+
+static size_t jlsGetThreadsCount(void)
+{
+    size_t threadsCount = jlsStatThreadsCount;
+
+    if (!threadsCount)
+    {
+        long processorsCount = sysconf(_SC_NPROCESSORS_ONLN);
+
+        threadsCount = processorsCount > 0 ? (size_t)processorsCount : 1;
+    }
+    if (threadsCount > JLS_STAT_THREADS_MAX)
+    {
+        threadsCount = JLS_STAT_THREADS_MAX;
+    }
+
+    return threadsCount;
+}
+
+static bool jlsCheckIsByteCollation(void)
+{
+    const char *collatePtr = setlocale(LC_COLLATE, 0);
+
+    return collatePtr && (!strcmp(collatePtr, "C") || !strcmp(collatePtr, "POSIX"));
+}
+
+static void jlsRadixSortKeys(jlsSortKeyStruct *keysList, jlsSortKeyStruct *tempList, size_t count, size_t depth)
+{
+    while (count >= JLS_RADIX_SORT_THRESHOLD)
+    {
+        size_t bucketsList[JLS_RADIX_BUCKETS_COUNT] = {0};
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            ++bucketsList[JLS_RADIX_BUCKET(&keysList[i], depth)];
+        }
+
+        // Все ключи закончились, а значит равны
+        if (bucketsList[0] == count)
+        {
+            return;
+        }
+
+        // Общий байт у всех ключей: распределение не нужно
+        if (bucketsList[JLS_RADIX_BUCKET(&keysList[0], depth)] == count)
+        {
+            ++depth;
+            continue;
+        }
+
+        // Количество ключей в корзинах заменяется на начало корзин
+        for (size_t bucket = 0, start = 0; bucket < JLS_RADIX_BUCKETS_COUNT; ++bucket)
+        {
+            size_t bucketCount = bucketsList[bucket];
+
+            bucketsList[bucket]  = start;
+            start               += bucketCount;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            tempList[bucketsList[JLS_RADIX_BUCKET(&keysList[i], depth)]++] = keysList[i];
+        }
+
+        memcpy(keysList, tempList, count * sizeof(jlsSortKeyStruct));
+
+        // После распределения bucketsList[bucket] - конец корзины, он же начало следующей
+        for (size_t bucket = 1; bucket < JLS_RADIX_BUCKETS_COUNT; ++bucket)
+        {
+            size_t start = bucketsList[bucket - 1];
+
+            if (bucketsList[bucket] - start > 1)
+            {
+                jlsRadixSortKeys(&keysList[start], tempList, bucketsList[bucket] - start, depth + 1);
+            }
+        }
+
+        return;
+    }
+
+    jlsInsertionSortKeys(keysList, count, depth);
+}
+
+static void jlsInsertionSortKeys(jlsSortKeyStruct *keysList, size_t count, size_t depth)
+{
+    for (size_t i = 1; i < count; ++i)
+    {
+        jlsSortKeyStruct key      = keysList[i];
+        size_t           position = i;
+
+        while (position > 0 && jlsSortKeysCompare(&keysList[position - 1], &key, depth) > 0)
+        {
+            keysList[position] = keysList[position - 1];
+            --position;
+        }
+
+        keysList[position] = key;
+    }
+}
+
+static bool jlsCheckIsUnsafe(const char *stringPtr, bool *isOkPtr)
+{
+    bool isOk = true;
+
+    if (!isOkPtr)
+    {
+        isOkPtr = &isOk;
+    }
+
+    *isOkPtr = true;
+
+    if (!stringPtr)
+    {
+        *isOkPtr = false;
+        return false;
+    }
+
+    if (!jlsIsCodesetChecked)
+    {
+        jlsIsCodesetUtf8    = !strcmp(nl_langinfo(CODESET), "UTF-8");
+        jlsIsCodesetChecked = true;
+    }
+
+    size_t stringLength = strlen(stringPtr);
+    size_t offset       = 0;
+
+    while (true)
+    {
+        offset += jlsScanSafeAscii(&stringPtr[offset], stringLength - offset);
+        if (offset == stringLength)
+        {
+            return false;
+        }
+
+        if (!(stringPtr[offset] & 0x80))
+        {
+            return true;
+        }
+
+        // Пропущенные байты - ASCII, поэтому символ начинается с offset в любой кодировке
+        if (!jlsIsCodesetUtf8)
+        {
+            return jlsCheckIsUnsafeMultibyte(&stringPtr[offset], stringLength - offset);
+        }
+
+        uint32_t codePoint       = 0;
+        size_t   codePointLength = 0;
+
+        codePointLength = jlsDecodeUtf8((const unsigned char *)&stringPtr[offset], stringLength - offset, &codePoint);
+
+        // Символы, имеющие особое значение для командной оболочки, - ASCII, поэтому проверяется только печатаемость
+        if (!codePointLength || !jlsCheckIsPrintable(codePoint))
+        {
+            return true;
+        }
+
+        offset += codePointLength;
+    }
+}
+
+static bool jlsCheckIsUnsafeMultibyte(const char *stringPtr, size_t stringLength)
+{
+    while (stringLength > 0)
     {
         bool      isPrintable    = true;
         wchar_t   wideChar       = L'\0';
@@ -1468,3 +2859,244 @@ static bool jlsCheckIsUnsafe(const char *stringPtr, bool *isOkPtr)
 
     return false;
 }
+
+static size_t jlsScanSafeAscii(const char *stringPtr, size_t length)
+{
+    size_t offset = 0;
+
+#ifdef __SSE2__
+    while (length - offset >= sizeof(__m128i))
+    {
+        __m128i block  = _mm_loadu_si128((const __m128i *)&stringPtr[offset]);
+        // Сравнение знаковое, поэтому байты не ASCII также меньше '#'
+        __m128i unsafe = _mm_cmplt_epi8(block, _mm_set1_epi8('#'));
+
+        unsafe = _mm_or_si128(unsafe, _mm_cmpeq_epi8(block, _mm_set1_epi8('$')));
+        unsafe = _mm_or_si128(unsafe, JLS_SSE2_IN_RANGE(block, '&', '*'));
+        unsafe = _mm_or_si128(unsafe, JLS_SSE2_IN_RANGE(block, ';', '<'));
+        unsafe = _mm_or_si128(unsafe, JLS_SSE2_IN_RANGE(block, '>', '?'));
+        unsafe = _mm_or_si128(unsafe, JLS_SSE2_IN_RANGE(block, '[', ']'));
+        unsafe = _mm_or_si128(unsafe, _mm_cmpeq_epi8(block, _mm_set1_epi8('`')));
+        unsafe = _mm_or_si128(unsafe, JLS_SSE2_IN_RANGE(block, '{', '}'));
+        unsafe = _mm_or_si128(unsafe, _mm_cmpeq_epi8(block, _mm_set1_epi8(0x7F)));
+
+        int mask = _mm_movemask_epi8(unsafe);
+        if (mask)
+        {
+            return offset + __builtin_ctz(mask);
+        }
+
+        offset += sizeof(__m128i);
+    }
+#endif
+
+    while (offset < length)
+    {
+        unsigned char symbol = (unsigned char)stringPtr[offset];
+
+        if ((symbol & 0x80) || ((jlsAsciiUnsafeBitmap[symbol / 64] >> (symbol % 64)) & 1))
+        {
+            break;
+        }
+
+        ++offset;
+    }
+
+    return offset;
+}
+
+static size_t jlsDecodeUtf8(const unsigned char *stringPtr, size_t length, uint32_t *codePointPtr)
+{
+    size_t   codePointLength = jlsUtf8LengthsList[stringPtr[0] >> 3];
+    uint32_t codePoint       = stringPtr[0] & jlsUtf8MasksList[codePointLength];
+
+    if (!codePointLength || codePointLength > length)
+    {
+        return 0;
+    }
+
+    for (size_t i = 1; i < codePointLength; ++i)
+    {
+        if ((stringPtr[i] & 0xC0) != 0x80)
+        {
+            return 0;
+        }
+
+        codePoint = (codePoint << 6) | (stringPtr[i] & 0x3F);
+    }
+
+    if (codePoint < jlsUtf8MinimumsList[codePointLength] || codePoint >= JLS_UNICODE_COUNT ||
+        (codePoint >= 0xD800 && codePoint <= 0xDFFF))
+    {
+        return 0;
+    }
+
+    *codePointPtr = codePoint;
+
+    return codePointLength;
+}
+
+static bool jlsCheckIsPrintable(uint32_t codePoint)
+{
+    size_t block = codePoint / JLS_PRINTABLE_BLOCK_SIZE;
+
+    if (!jlsPrintableBlocksList[block])
+    {
+        for (uint32_t i = block * JLS_PRINTABLE_BLOCK_SIZE; i < (block + 1) * JLS_PRINTABLE_BLOCK_SIZE; ++i)
+        {
+            if (iswprint((wint_t)i))
+            {
+                jlsPrintableBitmap[i / 64] |= (uint64_t)1 << (i % 64);
+            }
+        }
+
+        jlsPrintableBlocksList[block] = true;
+    }
+
+    return (jlsPrintableBitmap[codePoint / 64] >> (codePoint % 64)) & 1;
+}
+
+static void jlsGetFilesInfoParallel(int dirFd, const char *const *namesList, fileInfoStruct *const *fileInfoList, size_t count, size_t threadsCount, bool *isOkPtr)
+{
+    pthread_t         threadsList[JLS_STAT_THREADS_MAX];
+    size_t            startedCount = 0;
+    jlsStatWorkStruct work         = 
+    {
+        .dirFd        = dirFd,
+        .namesList    = namesList,
+        .fileInfoList = fileInfoList,
+        .count        = count,
+        .next         = 0,
+        .isOk         = true
+    };
+
+    // Если поток создать не удалось, работа распределяется между уже запущенными
+    for (size_t i = 1; i < threadsCount; ++i)
+    {
+        if (pthread_create(&threadsList[startedCount], 0, jlsStatWorker, &work))
+        {
+            break;
+        }
+        ++startedCount;
+    }
+
+    jlsStatWorker(&work);
+
+    for (size_t i = 0; i < startedCount; ++i)
+    {
+        pthread_join(threadsList[i], 0);
+    }
+
+    *isOkPtr = work.isOk;
+}
+
+static void *jlsStatWorker(void *workPtr)
+{
+    jlsStatWorkStruct     *statWorkPtr = workPtr;
+    fileInfoContextStruct  context     = {0};
+
+    while (__atomic_load_n(&statWorkPtr->isOk, __ATOMIC_RELAXED))
+    {
+        size_t begin = __atomic_fetch_add(&statWorkPtr->next, JLS_STAT_CHUNK_SIZE, __ATOMIC_RELAXED);
+        size_t end   = begin + JLS_STAT_CHUNK_SIZE;
+
+        if (begin >= statWorkPtr->count)
+        {
+            break;
+        }
+        if (end > statWorkPtr->count)
+        {
+            end = statWorkPtr->count;
+        }
+
+        for (size_t i = begin; i < end; ++i)
+        {
+            bool isFileOk = true;
+
+            fileInfoGetContextAt(&context, statWorkPtr->dirFd, statWorkPtr->namesList[i], statWorkPtr->fileInfoList[i], true, &isFileOk);
+            if (!isFileOk)
+            {
+                __atomic_store_n(&statWorkPtr->isOk, false, __ATOMIC_RELAXED);
+                break;
+            }
+        }
+    }
+
+    fileInfoContextClear(&context);
+
+    return 0;
+}
+
+static void jlsPrintPrepare(bool *isOkPtr)
+{
+    *isOkPtr = true;
+
+    if (jlsIsColorModeEnabled)
+    {
+        // Таблица цветов строится один раз при первом обращении
+        jlsResetColorPtr = colorGetReset();
+        jlsUpdateMaxVisibleChars();
+    }
+}
+
+static void jlsPrintFilesRows(const jlsFilesListStruct *filesListPtr, const jlsAlignmentStruct *alignmentPtr, jlsSafeTypesEnum safeType, bool *isOkPtr)
+{
+    *isOkPtr = true;
+
+    for (size_t i = 0; i < filesListPtr->count; ++i)
+    {
+        const fileInfoStruct *fileInfoPtr = filesListPtr->list[i];
+
+        fileInfoColumnsStruct columns = {0};
+
+        fileInfoToColumns(fileInfoPtr, &columns, isOkPtr);
+        if (!*isOkPtr)
+        {
+            return;
+        }
+
+        colorFileTargetStruct colors = {0};
+
+        if (jlsIsColorModeEnabled)
+        {
+            colors = colorFileToESC(fileInfoPtr, isOkPtr);
+            if (!*isOkPtr)
+            {
+                return;
+            }
+        }
+
+        jlsPrintFileInfo(&columns, alignmentPtr, safeType, &colors, isOkPtr);
+        if (!*isOkPtr)
+        {
+            return;
+        }
+    }
+}
+
+static void jlsGetFilesInfo(int dirFd, const char *const *namesList, fileInfoStruct *const *fileInfoList, size_t count, bool *isOkPtr)
+{
+    *isOkPtr = true;
+
+    size_t threadsCount = jlsGetThreadsCount();
+
+    if (threadsCount > 1 && count >= jlsStatParallelThreshold)
+    {
+        jlsGetFilesInfoParallel(dirFd, namesList, fileInfoList, count, threadsCount, isOkPtr);
+    }
+    else if (count >= jlsStatBatchThreshold)
+    {
+        fileInfoGetBatchAt(dirFd, namesList, fileInfoList, count, true, isOkPtr);
+    }
+    else
+    {
+        fileInfoContextStruct context = {0};
+
+        for (size_t i = 0; i < count && *isOkPtr; ++i)
+        {
+            fileInfoGetContextAt(&context, dirFd, namesList[i], fileInfoList[i], true, isOkPtr);
+        }
+
+        fileInfoContextClear(&context);
+    }
+}
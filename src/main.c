@@ -9,8 +9,11 @@
 #include <string.h>
 #include <locale.h>
 #include <unistd.h>
+#include <errno.h>
 #include "fileInfo.h"
 #include "jls.h"
+#include "idName.h"
+#include "output.h"
 
 int main(int argc, char *argv[])
 {
@@ -19,9 +22,9 @@ int main(int argc, char *argv[])
     setlocale(LC_ALL, "");
     
     // Объявление переменных, используемых в cleanup
-    jlsFilesListStruct jlsFilesList = {0};
-    char             **filesList    = 0;
-    char             **dirsList     = 0;
+    jlsFilesListStruct  jlsFilesList = {0};
+    fileInfoStruct     *fileInfoPtr  = 0;
+    char              **dirsList     = 0;
 
     /*
         Параметры ПО
@@ -33,6 +36,8 @@ int main(int argc, char *argv[])
     {
         jlsIsSafeModeEnabled  = true;
         jlsIsColorModeEnabled = true;
+
+        outputIsLineFlushEnabled = true;
     }
 
     /*
@@ -81,6 +86,82 @@ int main(int argc, char *argv[])
                 continue;
             }
             
+            if (strcmp(arg, "-U")         == 0 ||
+                strcmp(arg, "--unsorted") == 0)
+            {
+                jlsIsStreamModeEnabled = true;
+                continue;
+            }
+            
+            if (strcmp(arg, "-r")        == 0 ||
+                strcmp(arg, "--reverse") == 0)
+            {
+                jlsSortOrder = jlsSortDescend;
+                continue;
+            }
+            
+            if (strcmp(arg, "-v")             == 0 ||
+                strcmp(arg, "--natural-sort") == 0)
+            {
+                jlsSortSpec = (jlsSortSpecStruct){.fieldsList = {jlsSortFieldVersion}, .count = 1};
+                continue;
+            }
+            
+            if (strncmp(arg, "--sort=", strlen("--sort=")) == 0)
+            {
+                char *specPtr = arg + strlen("--sort=");
+
+                jlsSortSpecParse(specPtr, &jlsSortSpec, &isOk);
+                if (!isOk)
+                {
+                    fprintf(stderr, "jls: Invalid sort \"%s\"\n", specPtr);
+                    goto cleanup;
+                }
+                continue;
+            }
+            
+            if (strcmp(arg, "--dont-sync") == 0)
+            {
+                fileInfoIsDontSyncEnabled = true;
+                continue;
+            }
+            
+            if (strncmp(arg, "--threads=", strlen("--threads=")) == 0)
+            {
+                char *countPtr = arg + strlen("--threads=");
+                char *endPtr   = 0;
+
+                errno = 0;
+                unsigned long threadsCount = strtoul(countPtr, &endPtr, 10);
+                if (errno || endPtr == countPtr || *endPtr != '\0' || countPtr[0] == '-')
+                {
+                    fprintf(stderr, "jls: Invalid threads count \"%s\"\n", countPtr);
+                    isOk = false;
+                    goto cleanup;
+                }
+
+                jlsStatThreadsCount = threadsCount;
+                continue;
+            }
+            
+            if (strncmp(arg, "--top=", strlen("--top=")) == 0)
+            {
+                char *countPtr = arg + strlen("--top=");
+                char *endPtr   = 0;
+
+                errno = 0;
+                unsigned long topCount = strtoul(countPtr, &endPtr, 10);
+                if (errno || endPtr == countPtr || *endPtr != '\0' || countPtr[0] == '-' || !topCount)
+                {
+                    fprintf(stderr, "jls: Invalid top count \"%s\"\n", countPtr);
+                    isOk = false;
+                    goto cleanup;
+                }
+
+                jlsTopCount = topCount;
+                continue;
+            }
+            
             if (strcmp(arg, "-test")       == 0 ||
                 strcmp(arg, "--test-mode") == 0)
             {
@@ -117,15 +198,6 @@ int main(int argc, char *argv[])
     /*
         Формирование списка файлов и директорий, вывод информации о несуществующих файлах/директориях
     */
-       
-    int filesCount = 0;
-    filesList = calloc(argc - filesIndex, sizeof(char *));
-    if (!filesList)
-    {
-        isOk = false;
-        goto cleanup;
-    }
-
 
     int dirsCount = 0;
     dirsList = calloc(argc - filesIndex, sizeof(char *));
@@ -135,6 +207,9 @@ int main(int argc, char *argv[])
         goto cleanup;
     }
 
+    // Для файлов из аргументов total не выводится
+    fileInfoFields = fileInfoFieldAll & ~fileInfoFieldBlocks;
+
     for (int i = filesIndex; i < argc; ++i)
     {
         char *filePtr = argv[i];
@@ -150,57 +225,76 @@ int main(int argc, char *argv[])
             }
             continue;
         }
-        if (!fileInfoSetActiveFile(filePtr))
+
+        fileInfoPtr = calloc(1, sizeof(fileInfoStruct));
+        if (!fileInfoPtr)
         {
+            isOk = false;
+            goto cleanup;
+        }
+
+        bool isFileOk = true;
+
+        fileInfoGet(filePtr, fileInfoPtr, true, &isFileOk);
+        if (!isFileOk)
+        {
+            free(fileInfoPtr);
+            fileInfoPtr = 0;
             continue;
         }
 
-        if (fileInfoGetType(0) == fileInfoTypeDirectory)
+        if (fileInfoPtr->type == fileInfoTypeDirectory)
         {
             dirsList[dirsCount++] = filePtr;
+
+            fileInfoClear(fileInfoPtr);
+            free(fileInfoPtr);
+            fileInfoPtr = 0;
+            continue;
         }
-        else
+
+        // Файл выводится под тем именем, под которым он был передан
+        free(fileInfoPtr->fileNamePtr);
+        fileInfoPtr->fileNamePtr = strdup(filePtr);
+        if (!fileInfoPtr->fileNamePtr)
         {
-            filesList[filesCount++] = filePtr;
+            isOk = false;
+            goto cleanup;
         }
+
+        jlsFilesListAppend(&jlsFilesList, fileInfoPtr, &isOk);
+        if (!isOk)
+        {
+            goto cleanup;
+        }
+        fileInfoPtr = 0;
     }
 
+    fileInfoFields = fileInfoFieldAll;
+
     /*
         Вывод информации о файлах
     */
 
-    jlsFilesList.count = filesCount;
-    jlsFilesList.list  = calloc(filesCount, sizeof(jlsFilesList.list));
-    if (!jlsFilesList.list)
-    {
-        isOk = false;
-        goto cleanup;
-    }
-
-    for (int i = 0; i < filesCount; ++i)
-    {
-        jlsFilesList.list[i] = filesList[i];
-    }
-
     jlsAlignmentStruct alignment = {0};
-    alignment = jlsCalculateAlignment("", &jlsFilesList, &isOk);
+    alignment = jlsCalculateAlignment(&jlsFilesList, &isOk);
     if (!isOk)
     {
         goto cleanup;
     }
 
     jlsSafeTypesEnum safeType = {0};
-    safeType = jlsCalculateSafeType("", &jlsFilesList, &isOk);
+    safeType = jlsCalculateSafeType(&jlsFilesList, &isOk);
     if (!isOk)
     {
         goto cleanup;
     }
 
-    for (int i = 0; i < filesCount; ++i)
+    if (jlsFilesList.count)
     {
-        if (jls(filesList[i], &alignment, safeType) != 0)
+        jlsPrintFiles(&jlsFilesList, &alignment, safeType, &isOk);
+        if (!isOk)
         {
-            isOk = false;
             goto cleanup;
         }
     }
@@ -211,9 +305,12 @@ int main(int argc, char *argv[])
 
     for (int i = 0; i < dirsCount; ++i)
     {
-        if (filesCount > 0)
+        if (jlsFilesList.count > 0)
         {
-            printf("\n%s:\n", dirsList[i]);
+            outputNewLine();
+            outputWriteString(dirsList[i]);
+            outputWriteChar(':');
+            outputNewLine();
         }
 
         if (jls(dirsList[i], 0, jlsSafeTypeNone) != 0)
@@ -224,10 +321,11 @@ int main(int argc, char *argv[])
     }
 
 cleanup:
-    if (filesList)
+    if (fileInfoPtr)
     {
-        free(filesList);
-        filesList = 0;
+        fileInfoClear(fileInfoPtr);
+        free(fileInfoPtr);
+        fileInfoPtr = 0;
     }
 
     if (dirsList)
@@ -236,14 +334,18 @@ cleanup:
         dirsList = 0;
     }
 
-    if (jlsFilesList.list)
+    jlsFilesListClear(&jlsFilesList);
+
+    idNameClear();
+
+    bool isFlushOk = true;
+
+    outputFlush(&isFlushOk);
+    if (!isFlushOk)
     {
-        free(jlsFilesList.list);
-        jlsFilesList.list = 0;
+        isOk = false;
     }
 
-    fileInfoClearActiveFile();
-
     if (isOk)
     {
         return 0;
@@ -0,0 +1,216 @@
+/// @file       output.c
+/// @brief      См. output.h
+/// @author     Тузиков Г.А. janisrus35@gmail.com
+
+#include "output.h"
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/uio.h>
+
+/*
+    Прототипы внутренних функций
+*/
+
+/// @brief      Функция записи списка блоков в STDOUT_FILENO
+/// @details    Данная функция выполняет writev() до тех пор, пока не будут записаны все блоки.
+///                 В случае ошибки устанавливает outputIsError
+/// @param[in]  iovList  Список блоков. Изменяется в процессе записи
+/// @param[in]  iovCount Количество блоков
+static void outputWriteAll(struct iovec *iovList, int iovCount);
+
+/// @brief      Функция добавления пробелов в буфер вывода
+/// @param[in]  count Количество пробелов
+static void outputWriteSpaces(size_t count);
+
+/*
+    Внутренние переменные
+*/
+
+/// @brief      Буфер вывода
+char outputBuffer[OUTPUT_BUFFER_SIZE] = {0};
+
+/// @brief      Количество занятых байт outputBuffer
+size_t outputBufferUsed = 0;
+
+/// @brief      Флаг ошибки записи
+bool outputIsError = false;
+
+/*
+    Переменные
+*/
+
+bool outputIsLineFlushEnabled = false;
+
+/*
+    Функции
+*/
+
+size_t outputWrite(const char *dataPtr, size_t length)
+{
+    if (!dataPtr || !length)
+    {
+        return 0;
+    }
+
+    if (OUTPUT_BUFFER_SIZE - outputBufferUsed >= length)
+    {
+        memcpy(&outputBuffer[outputBufferUsed], dataPtr, length);
+        outputBufferUsed += length;
+        return length;
+    }
+
+    // Данные не помещаются: буфер и данные записываются одним вызовом
+    struct iovec iovList[2] =
+    {
+        {.iov_base = &outputBuffer[0],  .iov_len = outputBufferUsed},
+        {.iov_base = (void *)dataPtr,   .iov_len = length}
+    };
+
+    outputWriteAll(&iovList[0], 2);
+    outputBufferUsed = 0;
+
+    return length;
+}
+
+size_t outputWriteString(const char *stringPtr)
+{
+    if (!stringPtr)
+    {
+        return 0;
+    }
+
+    return outputWrite(stringPtr, strlen(stringPtr));
+}
+
+size_t outputWriteChar(char symbol)
+{
+    if (outputBufferUsed == OUTPUT_BUFFER_SIZE)
+    {
+        bool isOk = true;
+
+        outputFlush(&isOk);
+    }
+
+    outputBuffer[outputBufferUsed++] = symbol;
+
+    return 1;
+}
+
+size_t outputWritePadded(const char *stringPtr, size_t length, size_t width, bool isLeftAligned)
+{
+    size_t padding = width > length ? width - length : 0;
+
+    if (!isLeftAligned)
+    {
+        outputWriteSpaces(padding);
+    }
+
+    outputWrite(stringPtr, length);
+
+    if (isLeftAligned)
+    {
+        outputWriteSpaces(padding);
+    }
+
+    return length + padding;
+}
+
+void outputNewLine(void)
+{
+    outputWriteChar('\n');
+
+    if (outputIsLineFlushEnabled)
+    {
+        bool isOk = true;
+
+        outputFlush(&isOk);
+    }
+}
+
+void outputFlush(bool *isOkPtr)
+{
+    bool isOk = true;
+
+    if (!isOkPtr)
+    {
+        isOkPtr = &isOk;
+    }
+
+    *isOkPtr = true;
+
+    if (outputBufferUsed)
+    {
+        struct iovec iov = {.iov_base = &outputBuffer[0], .iov_len = outputBufferUsed};
+
+        outputWriteAll(&iov, 1);
+        outputBufferUsed = 0;
+    }
+
+    if (outputIsError)
+    {
+        *isOkPtr = false;
+    }
+}
+
+/*
+    Внутренние функции
+*/
+
+static void outputWriteAll(struct iovec *iovList, int iovCount)
+{
+    // После ошибки вывод отбрасывается
+    if (outputIsError)
+    {
+        return;
+    }
+
+    while (iovCount)
+    {
+        ssize_t written = writev(STDOUT_FILENO, iovList, iovCount);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            outputIsError = true;
+            return;
+        }
+
+        // Пропуск полностью записанных блоков и сдвиг начала частично записанного
+        while (iovCount && (size_t)written >= iovList->iov_len)
+        {
+            written -= iovList->iov_len;
+            ++iovList;
+            --iovCount;
+        }
+
+        if (iovCount)
+        {
+            iovList->iov_base  = (char *)iovList->iov_base + written;
+            iovList->iov_len  -= written;
+        }
+    }
+}
+
+static void outputWriteSpaces(size_t count)
+{
+    static const char spaces[] = "                                                                ";
+
+    if (OUTPUT_BUFFER_SIZE - outputBufferUsed >= count)
+    {
+        memset(&outputBuffer[outputBufferUsed], ' ', count);
+        outputBufferUsed += count;
+        return;
+    }
+
+    while (count)
+    {
+        size_t length = count < sizeof(spaces) - 1 ? count : sizeof(spaces) - 1;
+
+        outputWrite(&spaces[0], length);
+        count -= length;
+    }
+}
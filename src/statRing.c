@@ -0,0 +1,347 @@
+/// @file       statRing.c
+/// @brief      См. statRing.h
+/// @author     Тузиков Г.А. janisrus35@gmail.com
+
+#define _GNU_SOURCE
+
+#include "statRing.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+#if defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#endif
+#endif
+
+#if defined(IORING_OFF_SQ_RING) && defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && defined(__NR_io_uring_register)
+/// @brief      Признак доступности io_uring при сборке
+#define STAT_RING_IS_AVAILABLE
+#endif
+
+/*
+    Функции
+*/
+
+#ifdef STAT_RING_IS_AVAILABLE
+
+void statRingOpen(statRingStruct *ringPtr, unsigned int depth, bool *isOkPtr)
+{
+    bool isOk = true;
+
+    if (!isOkPtr)
+    {
+        isOkPtr = &isOk;
+    }
+
+    *isOkPtr = true;
+
+    if (!ringPtr || !depth)
+    {
+        *isOkPtr = false;
+        return;
+    }
+
+    memset(ringPtr, 0, sizeof(statRingStruct));
+    ringPtr->fd = -1;
+
+    // Объявление переменных, используемых в cleanup
+    struct io_uring_probe *probePtr = 0;
+
+    struct io_uring_params params = {0};
+
+    ringPtr->fd = (int)syscall(__NR_io_uring_setup, depth, &params);
+    if (ringPtr->fd < 0)
+    {
+        *isOkPtr = false;
+        goto cleanup;
+    }
+
+    // statx через io_uring поддерживается с Linux 5.6
+    probePtr = calloc(1, sizeof(struct io_uring_probe) + 256 * sizeof(struct io_uring_probe_op));
+    if (!probePtr)
+    {
+        *isOkPtr = false;
+        goto cleanup;
+    }
+
+    if (syscall(__NR_io_uring_register, ringPtr->fd, IORING_REGISTER_PROBE, probePtr, 256) < 0 ||
+        probePtr->ops_len <= IORING_OP_STATX                                                  ||
+        !(probePtr->ops[IORING_OP_STATX].flags & IO_URING_OP_SUPPORTED))
+    {
+        *isOkPtr = false;
+        goto cleanup;
+    }
+
+    ringPtr->depth      = params.sq_entries;
+    ringPtr->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+    ringPtr->cqRingSize = params.cq_off.cqes  + params.cq_entries * sizeof(struct io_uring_cqe);
+    ringPtr->sqesSize   = params.sq_entries * sizeof(struct io_uring_sqe);
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        if (ringPtr->cqRingSize > ringPtr->sqRingSize)
+        {
+            ringPtr->sqRingSize = ringPtr->cqRingSize;
+        }
+        ringPtr->cqRingSize = ringPtr->sqRingSize;
+    }
+
+    ringPtr->sqRingPtr = mmap(0, ringPtr->sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringPtr->fd, IORING_OFF_SQ_RING);
+    if (ringPtr->sqRingPtr == MAP_FAILED)
+    {
+        ringPtr->sqRingPtr = 0;
+        *isOkPtr = false;
+        goto cleanup;
+    }
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        ringPtr->cqRingPtr = ringPtr->sqRingPtr;
+    }
+    else
+    {
+        ringPtr->cqRingPtr = mmap(0, ringPtr->cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringPtr->fd, IORING_OFF_CQ_RING);
+        if (ringPtr->cqRingPtr == MAP_FAILED)
+        {
+            ringPtr->cqRingPtr = 0;
+            *isOkPtr = false;
+            goto cleanup;
+        }
+    }
+
+    ringPtr->sqesPtr = mmap(0, ringPtr->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringPtr->fd, IORING_OFF_SQES);
+    if (ringPtr->sqesPtr == MAP_FAILED)
+    {
+        ringPtr->sqesPtr = 0;
+        *isOkPtr = false;
+        goto cleanup;
+    }
+
+    ringPtr->sqHeadPtr  = (unsigned int *)((char *)ringPtr->sqRingPtr + params.sq_off.head);
+    ringPtr->sqTailPtr  = (unsigned int *)((char *)ringPtr->sqRingPtr + params.sq_off.tail);
+    ringPtr->sqMaskPtr  = (unsigned int *)((char *)ringPtr->sqRingPtr + params.sq_off.ring_mask);
+    ringPtr->sqArrayPtr = (unsigned int *)((char *)ringPtr->sqRingPtr + params.sq_off.array);
+    ringPtr->cqHeadPtr  = (unsigned int *)((char *)ringPtr->cqRingPtr + params.cq_off.head);
+    ringPtr->cqTailPtr  = (unsigned int *)((char *)ringPtr->cqRingPtr + params.cq_off.tail);
+    ringPtr->cqMaskPtr  = (unsigned int *)((char *)ringPtr->cqRingPtr + params.cq_off.ring_mask);
+    ringPtr->cqesPtr    = (char *)ringPtr->cqRingPtr + params.cq_off.cqes;
+
+cleanup:
+
+    if (probePtr)
+    {
+        free(probePtr);
+        probePtr = 0;
+    }
+
+    if (!*isOkPtr)
+    {
+        statRingClose(ringPtr);
+    }
+}
+
+bool statRingPrepareStatx(statRingStruct *ringPtr, int dirFd, const char *filePtr, int flags, unsigned int mask, struct statx *resultPtr, uint64_t userData)
+{
+    if (!ringPtr || !ringPtr->sqesPtr || !filePtr || !resultPtr)
+    {
+        return false;
+    }
+
+    unsigned int head = __atomic_load_n(ringPtr->sqHeadPtr, __ATOMIC_ACQUIRE);
+    unsigned int tail = *ringPtr->sqTailPtr;
+
+    if (tail - head >= ringPtr->depth)
+    {
+        return false;
+    }
+
+    unsigned int         index  = tail & *ringPtr->sqMaskPtr;
+    struct io_uring_sqe *sqePtr = &((struct io_uring_sqe *)ringPtr->sqesPtr)[index];
+
+    memset(sqePtr, 0, sizeof(struct io_uring_sqe));
+
+    sqePtr->opcode      = IORING_OP_STATX;
+    sqePtr->fd          = dirFd;
+    sqePtr->addr        = (uint64_t)(uintptr_t)filePtr;
+    sqePtr->len         = mask;
+    sqePtr->addr2       = (uint64_t)(uintptr_t)resultPtr;
+    sqePtr->statx_flags = (uint32_t)flags;
+    sqePtr->user_data   = userData;
+
+    ringPtr->sqArrayPtr[index] = index;
+
+    __atomic_store_n(ringPtr->sqTailPtr, tail + 1, __ATOMIC_RELEASE);
+
+    ++ringPtr->pendingCount;
+
+    return true;
+}
+
+void statRingSubmit(statRingStruct *ringPtr, unsigned int waitCount, bool *isOkPtr)
+{
+    bool isOk = true;
+
+    if (!isOkPtr)
+    {
+        isOkPtr = &isOk;
+    }
+
+    *isOkPtr = true;
+
+    if (!ringPtr || ringPtr->fd < 0)
+    {
+        *isOkPtr = false;
+        return;
+    }
+
+    do
+    {
+        long submitted = syscall(__NR_io_uring_enter,
+                                 ringPtr->fd,
+                                 ringPtr->pendingCount,
+                                 waitCount,
+                                 waitCount ? IORING_ENTER_GETEVENTS : 0,
+                                 0,
+                                 0);
+        if (submitted < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            *isOkPtr = false;
+            return;
+        }
+
+        ringPtr->pendingCount -= (unsigned int)submitted;
+    } while (ringPtr->pendingCount);
+}
+
+bool statRingReap(statRingStruct *ringPtr, uint64_t *userDataPtr, int32_t *resultPtr)
+{
+    if (!ringPtr || !ringPtr->cqesPtr || !userDataPtr || !resultPtr)
+    {
+        return false;
+    }
+
+    unsigned int head = *ringPtr->cqHeadPtr;
+    unsigned int tail = __atomic_load_n(ringPtr->cqTailPtr, __ATOMIC_ACQUIRE);
+
+    if (head == tail)
+    {
+        return false;
+    }
+
+    const struct io_uring_cqe *cqePtr = &((const struct io_uring_cqe *)ringPtr->cqesPtr)[head & *ringPtr->cqMaskPtr];
+
+    *userDataPtr = cqePtr->user_data;
+    *resultPtr   = cqePtr->res;
+
+    __atomic_store_n(ringPtr->cqHeadPtr, head + 1, __ATOMIC_RELEASE);
+
+    return true;
+}
+
+void statRingClose(statRingStruct *ringPtr)
+{
+    if (!ringPtr)
+    {
+        return;
+    }
+
+    if (ringPtr->sqesPtr)
+    {
+        munmap(ringPtr->sqesPtr, ringPtr->sqesSize);
+        ringPtr->sqesPtr = 0;
+    }
+
+    if (ringPtr->cqRingPtr && ringPtr->cqRingPtr != ringPtr->sqRingPtr)
+    {
+        munmap(ringPtr->cqRingPtr, ringPtr->cqRingSize);
+    }
+    ringPtr->cqRingPtr = 0;
+
+    if (ringPtr->sqRingPtr)
+    {
+        munmap(ringPtr->sqRingPtr, ringPtr->sqRingSize);
+        ringPtr->sqRingPtr = 0;
+    }
+
+    if (ringPtr->fd >= 0)
+    {
+        close(ringPtr->fd);
+    }
+
+    memset(ringPtr, 0, sizeof(statRingStruct));
+    ringPtr->fd = -1;
+}
+
+#else
+
+void statRingOpen(statRingStruct *ringPtr, unsigned int depth, bool *isOkPtr)
+{
+    (void)depth;
+
+    if (ringPtr)
+    {
+        memset(ringPtr, 0, sizeof(statRingStruct));
+        ringPtr->fd = -1;
+    }
+
+    if (isOkPtr)
+    {
+        *isOkPtr = false;
+    }
+}
+
+bool statRingPrepareStatx(statRingStruct *ringPtr, int dirFd, const char *filePtr, int flags, unsigned int mask, struct statx *resultPtr, uint64_t userData)
+{
+    (void)ringPtr;
+    (void)dirFd;
+    (void)filePtr;
+    (void)flags;
+    (void)mask;
+    (void)resultPtr;
+    (void)userData;
+
+    return false;
+}
+
+void statRingSubmit(statRingStruct *ringPtr, unsigned int waitCount, bool *isOkPtr)
+{
+    (void)ringPtr;
+    (void)waitCount;
+
+    if (isOkPtr)
+    {
+        *isOkPtr = false;
+    }
+}
+
+bool statRingReap(statRingStruct *ringPtr, uint64_t *userDataPtr, int32_t *resultPtr)
+{
+    (void)ringPtr;
+    (void)userDataPtr;
+    (void)resultPtr;
+
+    return false;
+}
+
+void statRingClose(statRingStruct *ringPtr)
+{
+    if (ringPtr)
+    {
+        memset(ringPtr, 0, sizeof(statRingStruct));
+        ringPtr->fd = -1;
+    }
+}
+
+// STAT_RING_IS_AVAILABLE
+#endif